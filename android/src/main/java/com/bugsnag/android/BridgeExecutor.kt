@@ -0,0 +1,150 @@
+package com.bugsnag.android
+
+import android.os.Build
+import android.os.Trace
+import java.util.concurrent.Executor
+import java.util.concurrent.LinkedBlockingQueue
+import java.util.concurrent.RejectedExecutionHandler
+import java.util.concurrent.ThreadFactory
+import java.util.concurrent.ThreadPoolExecutor
+import java.util.concurrent.TimeUnit
+
+/**
+ * A change to the native client's state that can be merged with the change made just before it.
+ */
+internal sealed class StateChange {
+    class Context(val context: String?) : StateChange()
+    class User(val id: String?, val email: String?, val name: String?) : StateChange()
+
+    /**
+     * Consecutive additions to one section. Each value is converted from the bridge's map when the
+     * change is applied, so that the conversion happens off the calling thread.
+     */
+    class AddMetadata(val section: String) : StateChange() {
+        val values = ArrayList<() -> Map<String, Any?>?>()
+    }
+}
+
+/**
+ * Runs bridge calls on one thread, in the order they were made, so that they do not hold up other
+ * native modules' calls on React Native's shared module thread.
+ *
+ * Consecutive state changes that have not started to be applied are coalesced: only the last
+ * context and the last user are applied, and additions to the same metadata section are combined.
+ * Any other call ends a run of state changes, so it sees every change made before it and none after.
+ *
+ * When [traced], each call runs in a trace section named after its method, so that benchmarks can
+ * measure the native time spent on bridge calls with systrace or Perfetto.
+ */
+internal class BridgeExecutor(
+    private val executor: Executor,
+    private val apply: (StateChange) -> Unit,
+    private val traced: Boolean = false
+) {
+
+    internal companion object {
+        /**
+         * How many calls may be waiting to run. Callers wait for a place once this many are queued.
+         */
+        private const val QUEUE_CAPACITY = 256
+
+        /**
+         * Shared by every module instance, so that calls made before and after a JS reload stay in order.
+         */
+        val sharedExecutor: Executor by lazy {
+            ThreadPoolExecutor(
+                1, 1, 0L, TimeUnit.MILLISECONDS,
+                LinkedBlockingQueue<Runnable>(QUEUE_CAPACITY),
+                ThreadFactory { runnable -> Thread(runnable, "Bugsnag React Native bridge").apply { isDaemon = true } },
+                RejectedExecutionHandler { runnable, pool ->
+                    // Waiting, rather than running on the caller, keeps calls in order.
+                    if (!pool.isShutdown) {
+                        pool.queue.put(runnable)
+                    }
+                }
+            )
+        }
+    }
+
+    /**
+     * The state changes that the most recently queued task will apply, while they can still be added to.
+     * Guarded by this.
+     */
+    private var openBatch: MutableList<StateChange>? = null
+
+    fun execute(name: String, block: () -> Unit) {
+        synchronized(this) {
+            openBatch = null
+        }
+        executor.execute { trace(name, block) }
+    }
+
+    fun updateState(change: StateChange) {
+        val batch = synchronized(this) {
+            openBatch?.let {
+                coalesce(it, change)
+                return
+            }
+            mutableListOf(change).also { openBatch = it }
+        }
+        executor.execute {
+            synchronized(this) {
+                if (openBatch === batch) {
+                    openBatch = null
+                }
+            }
+            trace("stateChanges") { batch.forEach(apply) }
+        }
+    }
+
+    private inline fun trace(name: String, block: () -> Unit) {
+        if (!traced || Build.VERSION.SDK_INT < Build.VERSION_CODES.JELLY_BEAN_MR2) {
+            block()
+            return
+        }
+        Trace.beginSection("Bugsnag bridge: $name")
+        try {
+            block()
+        } finally {
+            Trace.endSection()
+        }
+    }
+
+    private fun coalesce(batch: MutableList<StateChange>, change: StateChange) {
+        val last = batch.last()
+        when {
+            change is StateChange.Context && last is StateChange.Context -> batch[batch.size - 1] = change
+            change is StateChange.User && last is StateChange.User -> batch[batch.size - 1] = change
+            change is StateChange.AddMetadata && last is StateChange.AddMetadata && change.section == last.section ->
+                last.values.addAll(change.values)
+            else -> batch.add(change)
+        }
+    }
+}
+
+/**
+ * Merges consecutive additions to a section into as few maps as possible, without changing the
+ * result: a map is only merged into the previous one if they share no key that holds a map in both,
+ * as the client could merge those rather than replace them.
+ */
+internal fun coalesceMetadata(values: List<Map<String, Any?>?>): List<Map<String, Any?>?> {
+    val result = ArrayList<Map<String, Any?>?>()
+    var merged: HashMap<String, Any?>? = null
+    for (value in values) {
+        val current = merged
+        if (value == null) {
+            current?.let { result.add(it) }
+            result.add(null)
+            merged = null
+        } else if (current == null) {
+            merged = HashMap(value)
+        } else if (value.any { (key, obj) -> obj is Map<*, *> && current[key] is Map<*, *> }) {
+            result.add(current)
+            merged = HashMap(value)
+        } else {
+            current.putAll(value)
+        }
+    }
+    merged?.let { result.add(it) }
+    return result
+}
@@ -0,0 +1,184 @@
+package com.bugsnag.android;
+
+import androidx.annotation.NonNull;
+
+import com.facebook.react.modules.network.OkHttpClientFactory;
+import com.facebook.react.modules.network.OkHttpClientProvider;
+
+import java.io.IOException;
+import java.net.InetAddress;
+import java.net.InetSocketAddress;
+import java.net.Proxy;
+import java.util.HashMap;
+import java.util.List;
+import java.util.Map;
+
+import okhttp3.Call;
+import okhttp3.EventListener;
+import okhttp3.Handshake;
+import okhttp3.OkHttpClient;
+import okhttp3.Protocol;
+import okhttp3.Request;
+import okhttp3.Response;
+
+/**
+ * Records a "request" breadcrumb, with timings, for each call made by React Native's OkHttp
+ * client. As requests are observed by an OkHttp {@link EventListener}, XMLHttpRequest and fetch
+ * need not be instrumented in JS, which is then told to leave them alone.
+ *
+ * <p>Call {@link #install()} after Bugsnag.start() in Application#onCreate(). Apps that set their
+ * own OkHttpClientFactory should instead add {@link #eventListenerFactory()} to its clients.
+ */
+public final class BugsnagNetworkBreadcrumbs {
+
+    private static volatile boolean enabled;
+
+    private BugsnagNetworkBreadcrumbs() {
+    }
+
+    /**
+     * Sets React Native's OkHttpClientFactory to one whose clients record network breadcrumbs.
+     */
+    public static void install() {
+        final EventListener.Factory factory = eventListenerFactory();
+        OkHttpClientProvider.setOkHttpClientFactory(new OkHttpClientFactory() {
+            @Override
+            public OkHttpClient createNewNetworkModuleClient() {
+                OkHttpClient.Builder builder = OkHttpClientProvider.createClientBuilder();
+                return builder.eventListenerFactory(factory).build();
+            }
+        });
+    }
+
+    /**
+     * Returns a factory of listeners that record network breadcrumbs, for use with a custom
+     * OkHttpClientFactory.
+     */
+    @NonNull
+    public static EventListener.Factory eventListenerFactory() {
+        enabled = true;
+        return new EventListener.Factory() {
+            @NonNull
+            @Override
+            public EventListener create(@NonNull Call call) {
+                return new Listener();
+            }
+        };
+    }
+
+    /**
+     * Whether network breadcrumbs are being recorded natively.
+     */
+    static boolean isEnabled() {
+        return enabled;
+    }
+
+    /**
+     * Collects the timings of a single call. OkHttp creates one per call, and calls it
+     * sequentially, so it needs no synchronization.
+     */
+    static final class Listener extends EventListener {
+
+        private final Map<String, Object> metadata = new HashMap<>();
+        private long callStart;
+        private long dnsStart;
+        private long connectStart;
+        private long secureConnectStart;
+        private long requestStart;
+        private long responseStart;
+
+        @Override
+        public void callStart(@NonNull Call call) {
+            callStart = System.nanoTime();
+            Request request = call.request();
+            metadata.put("request", request.method() + " " + request.url());
+        }
+
+        @Override
+        public void dnsStart(@NonNull Call call, @NonNull String domainName) {
+            dnsStart = System.nanoTime();
+        }
+
+        @Override
+        public void dnsEnd(@NonNull Call call, @NonNull String domainName,
+                           @NonNull List<InetAddress> inetAddressList) {
+            metadata.put("dnsDuration", millisSince(dnsStart));
+        }
+
+        @Override
+        public void connectStart(@NonNull Call call, @NonNull InetSocketAddress inetSocketAddress,
+                                 @NonNull Proxy proxy) {
+            connectStart = System.nanoTime();
+        }
+
+        @Override
+        public void secureConnectStart(@NonNull Call call) {
+            secureConnectStart = System.nanoTime();
+        }
+
+        @Override
+        public void secureConnectEnd(@NonNull Call call, Handshake handshake) {
+            metadata.put("tlsDuration", millisSince(secureConnectStart));
+        }
+
+        @Override
+        public void connectEnd(@NonNull Call call, @NonNull InetSocketAddress inetSocketAddress,
+                               @NonNull Proxy proxy, Protocol protocol) {
+            metadata.put("connectDuration", millisSince(connectStart));
+            if (protocol != null) {
+                metadata.put("protocol", protocol.toString());
+            }
+        }
+
+        @Override
+        public void requestHeadersStart(@NonNull Call call) {
+            requestStart = System.nanoTime();
+        }
+
+        @Override
+        public void requestBodyEnd(@NonNull Call call, long byteCount) {
+            metadata.put("requestBodySize", byteCount);
+        }
+
+        @Override
+        public void responseHeadersStart(@NonNull Call call) {
+            responseStart = System.nanoTime();
+            if (requestStart != 0) {
+                metadata.put("timeToFirstByte", (responseStart - requestStart) / 1000000);
+            }
+        }
+
+        @Override
+        public void responseHeadersEnd(@NonNull Call call, @NonNull Response response) {
+            metadata.put("status", response.code());
+        }
+
+        @Override
+        public void responseBodyEnd(@NonNull Call call, long byteCount) {
+            metadata.put("responseBodySize", byteCount);
+            metadata.put("responseDuration", millisSince(responseStart));
+        }
+
+        @Override
+        public void callEnd(@NonNull Call call) {
+            Object status = metadata.get("status");
+            boolean failed = status instanceof Integer && (Integer) status >= 400;
+            leaveBreadcrumb(failed ? "OkHttp call failed" : "OkHttp call succeeded");
+        }
+
+        @Override
+        public void callFailed(@NonNull Call call, @NonNull IOException ioe) {
+            metadata.put("error", ioe.toString());
+            leaveBreadcrumb("OkHttp call error");
+        }
+
+        private void leaveBreadcrumb(String message) {
+            metadata.put("duration", millisSince(callStart));
+            Bugsnag.leaveBreadcrumb(message, metadata, BreadcrumbType.REQUEST);
+        }
+
+        private static long millisSince(long start) {
+            return (System.nanoTime() - start) / 1000000;
+        }
+    }
+}
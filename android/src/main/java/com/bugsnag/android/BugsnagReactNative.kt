@@ -5,10 +5,15 @@ import com.facebook.react.bridge.Promise
 import com.facebook.react.bridge.ReactApplicationContext
 import com.facebook.react.bridge.ReactContextBaseJavaModule
 import com.facebook.react.bridge.ReactMethod
+import com.facebook.react.bridge.ReadableArray
 import com.facebook.react.bridge.ReadableMap
+import com.facebook.react.bridge.ReadableType
 import com.facebook.react.bridge.WritableMap
 import com.facebook.react.bridge.WritableNativeMap
 import com.facebook.react.modules.core.DeviceEventManagerModule.RCTDeviceEventEmitter
+import java.util.concurrent.Executors
+import java.util.concurrent.ScheduledExecutorService
+import java.util.concurrent.TimeUnit
 
 class BugsnagReactNative(private val reactContext: ReactApplicationContext) :
     ReactContextBaseJavaModule(reactContext) {
@@ -19,14 +24,68 @@ class BugsnagReactNative(private val reactContext: ReactApplicationContext) :
         private const val UPDATE_METADATA = "MetadataUpdate"
         private const val SYNC_KEY = "bugsnag::sync"
         private const val DATA_KEY = "data"
+
+        /**
+         * Set by JS when it skipped getPayloadInfo, so native must attach the app, device,
+         * breadcrumbs and threads itself.
+         */
+        private const val NATIVE_ENRICHMENT_KEY = "nativeEnrichment"
+
+        /**
+         * How long state changes are collected before the latest of each type is sent to JS, about
+         * one frame at 60 Hz.
+         */
+        private const val EMIT_INTERVAL_MS = 16L
+
+        /**
+         * Converts and emits state changes, so that neither happens on the thread that made them.
+         */
+        private val emitExecutor: ScheduledExecutorService by lazy {
+            Executors.newSingleThreadScheduledExecutor { runnable ->
+                Thread(runnable, "Bugsnag React Native sync").apply { isDaemon = true }
+            }
+        }
+
+        /**
+         * The result of the last [configure] call and the env it was for. The configuration is
+         * immutable once the native client has started, so every JS reload with the same env would
+         * get the same result. Kept here so that it outlives the module, which is recreated on reload.
+         */
+        @Volatile
+        private var configureCache: Pair<Map<String, Any?>, Map<String, Any?>>? = null
     }
 
     lateinit var bridge: RCTDeviceEventEmitter
     lateinit var plugin: BugsnagReactNativePlugin
     lateinit var logger: Logger
 
+    /**
+     * The latest event of each type that has not yet been sent, and whether a flush is scheduled.
+     * Both are guarded by [pendingEvents].
+     */
+    private val pendingEvents = LinkedHashMap<String, MessageEvent>()
+    private var flushScheduled = false
+
+    /**
+     * Runs the work of bridge calls, other than [configure] and [configureNotifier], off React
+     * Native's module thread. Replaced by tests to run it synchronously.
+     */
+    internal var bridgeExecutor = BridgeExecutor(BridgeExecutor.sharedExecutor, this::applyStateChange, traced = true)
+
     override fun getName(): String = "BugsnagReactNative"
 
+    /**
+     * Exports the configuration from an earlier [configure] call, e.g. before a JS reload or bridge
+     * restart, so that JS can read it without a blocking call and only needs to call
+     * [configureNotifier].
+     */
+    override fun getConstants(): Map<String, Any> {
+        // enrichesPayloads tells JS that dispatched events can omit what getPayloadInfo would provide.
+        val constants = mutableMapOf<String, Any>("enrichesPayloads" to true)
+        configureCache?.let { constants["configuration"] = it.second }
+        return constants
+    }
+
     fun logFailure(msg: String, exc: Throwable) {
         logger.e("Failed to call $msg on bugsnag-plugin-react-native, continuing", exc)
     }
@@ -50,11 +109,7 @@ class BugsnagReactNative(private val reactContext: ReactApplicationContext) :
             "added Bugsnag.start() in the onCreate() method of your Application subclass")
         }
         return try {
-            bridge = reactContext.getJSModule(RCTDeviceEventEmitter::class.java)
-            logger = client.logger
-            plugin = client.getPlugin(BugsnagReactNativePlugin::class.java) as BugsnagReactNativePlugin
-            plugin.registerForMessageEvents { emitEvent(it) }
-            plugin.configure(env.toHashMap()).toWritableMap()
+            configureWithClient(client, env).toWritableMap()
         } catch (exc: Throwable) {
             logFailure("configure", exc)
             WritableNativeMap()
@@ -62,26 +117,86 @@ class BugsnagReactNative(private val reactContext: ReactApplicationContext) :
     }
 
     /**
-     * Serializes a MessageEvent into a WritableMap and sends it across the React Bridge
+     * Used with the configuration from the module's constants. Records the JS notifier's details
+     * without blocking JS, and only reconfigures the plugin if they have changed.
+     */
+    @ReactMethod
+    fun configureNotifier(env: ReadableMap) {
+        // The constants are only exported once configure has succeeded, so the client has started.
+        val client = Bugsnag.getClient()
+        try {
+            configureWithClient(client, env)
+        } catch (exc: Throwable) {
+            logFailure("configureNotifier", exc)
+        }
+    }
+
+    private fun configureWithClient(client: Client, env: ReadableMap): Map<String, Any?> {
+        bridge = reactContext.getJSModule(RCTDeviceEventEmitter::class.java)
+        logger = client.logger
+        plugin = client.getPlugin(BugsnagReactNativePlugin::class.java) as BugsnagReactNativePlugin
+        plugin.registerForMessageEvents { emitEvent(it) }
+        val envMap: Map<String, Any?> = env.toHashMap()
+        val cached = configureCache
+        return if (cached != null && cached.first == envMap) {
+            cached.second
+        } else {
+            // Tells JS not to instrument XMLHttpRequest and fetch, as OkHttp calls are recorded natively
+            val nativeNetworkBreadcrumbs = BugsnagNetworkBreadcrumbs.isEnabled()
+            (plugin.configure(envMap) + ("nativeNetworkBreadcrumbs" to nativeNetworkBreadcrumbs))
+                .also { configureCache = Pair(envMap, it) }
+        }
+    }
+
+    /**
+     * Queues a MessageEvent to be sent across the React Bridge. Only the latest event of each type
+     * is sent, once [EMIT_INTERVAL_MS] have passed since the first was queued.
      */
-    @Suppress("UNCHECKED_CAST")
     fun emitEvent(event: MessageEvent) {
         logger.d("Received MessageEvent: ${event.type}")
+        synchronized(pendingEvents) {
+            pendingEvents[event.type] = event
+            if (flushScheduled) {
+                return
+            }
+            flushScheduled = true
+        }
+        emitExecutor.schedule({ flushEvents() }, EMIT_INTERVAL_MS, TimeUnit.MILLISECONDS)
+    }
 
+    internal fun flushEvents() {
+        val events = synchronized(pendingEvents) {
+            flushScheduled = false
+            ArrayList(pendingEvents.values).also { pendingEvents.clear() }
+        }
+        for (event in events) {
+            try {
+                bridge.emit(SYNC_KEY, serializeEvent(event))
+            } catch (exc: Throwable) {
+                logFailure("emitEvent", exc)
+            }
+        }
+    }
+
+    /**
+     * Serializes a MessageEvent into a WritableMap
+     */
+    @Suppress("UNCHECKED_CAST")
+    private fun serializeEvent(event: MessageEvent): WritableMap {
         val map = Arguments.createMap()
         map.putString("type", event.type)
 
         when (event.type) {
             UPDATE_CONTEXT -> map.putString(DATA_KEY, event.data as String?)
-            UPDATE_USER -> map.putMap(DATA_KEY, Arguments.makeNativeMap(event.data as Map<String, Any?>?))
-            UPDATE_METADATA -> map.putMap(DATA_KEY, Arguments.makeNativeMap(event.data as Map<String, Any?>?))
+            UPDATE_USER -> map.putMap(DATA_KEY, (event.data as Map<String, Any?>? ?: emptyMap()).toWritableMap())
+            UPDATE_METADATA -> map.putMap(DATA_KEY, (event.data as Map<String, Any?>? ?: emptyMap()).toWritableMap())
             else -> logger.w("Received unknown message event ${event.type}, ignoring")
         }
-        bridge.emit(SYNC_KEY, map)
+        return map
     }
 
     @ReactMethod
-    fun updateCodeBundleId(id: String?) {
+    fun updateCodeBundleId(id: String?) = bridgeExecutor.execute("updateCodeBundleId") {
         try {
             plugin.updateCodeBundleId(id)
         } catch (exc: Throwable) {
@@ -90,7 +205,7 @@ class BugsnagReactNative(private val reactContext: ReactApplicationContext) :
     }
 
     @ReactMethod
-    fun leaveBreadcrumb(map: ReadableMap) {
+    fun leaveBreadcrumb(map: ReadableMap) = bridgeExecutor.execute("leaveBreadcrumb") {
         try {
             plugin.leaveBreadcrumb(map.toHashMap())
         } catch (exc: Throwable) {
@@ -98,8 +213,43 @@ class BugsnagReactNative(private val reactContext: ReactApplicationContext) :
         }
     }
 
+    /**
+     * Leaves a batch of breadcrumbs that was encoded as JSON by JS, which crosses the bridge as a
+     * single string rather than a [ReadableArray] whose maps are each read through JNI.
+     */
+    @ReactMethod
+    fun leaveBreadcrumbsJSON(json: String) = bridgeExecutor.execute("leaveBreadcrumbsJSON") {
+        val batch = try {
+            JsonDecoder(json).decodeArray()
+        } catch (exc: Throwable) {
+            logFailure("leaveBreadcrumbsJSON", exc)
+            return@execute
+        }
+        for (breadcrumb in batch) {
+            try {
+                @Suppress("UNCHECKED_CAST")
+                (breadcrumb as? Map<String, Any?>)?.let { plugin.leaveBreadcrumb(it) }
+            } catch (exc: Throwable) {
+                logFailure("leaveBreadcrumbsJSON", exc)
+            }
+        }
+    }
+
+    @ReactMethod
+    fun leaveBreadcrumbs(batch: ReadableArray) = bridgeExecutor.execute("leaveBreadcrumbs") {
+        for (i in 0 until batch.size()) {
+            try {
+                if (batch.getType(i) == ReadableType.Map) {
+                    plugin.leaveBreadcrumb(batch.getMap(i)?.toHashMap())
+                }
+            } catch (exc: Throwable) {
+                logFailure("leaveBreadcrumbs", exc)
+            }
+        }
+    }
+
     @ReactMethod
-    fun startSession() {
+    fun startSession() = bridgeExecutor.execute("startSession") {
         try {
             plugin.startSession()
         } catch (exc: Throwable) {
@@ -108,7 +258,7 @@ class BugsnagReactNative(private val reactContext: ReactApplicationContext) :
     }
 
     @ReactMethod
-    fun pauseSession() {
+    fun pauseSession() = bridgeExecutor.execute("pauseSession") {
         try {
             plugin.pauseSession()
         } catch (exc: Throwable) {
@@ -117,7 +267,7 @@ class BugsnagReactNative(private val reactContext: ReactApplicationContext) :
     }
 
     @ReactMethod
-    fun resumeSession() {
+    fun resumeSession() = bridgeExecutor.execute("resumeSession") {
         try {
             plugin.resumeSession()
         } catch (exc: Throwable) {
@@ -127,24 +277,61 @@ class BugsnagReactNative(private val reactContext: ReactApplicationContext) :
 
     @ReactMethod
     fun updateContext(context: String?) {
-        try {
-            plugin.updateContext(context)
-        } catch (exc: Throwable) {
-            logFailure("updateContext", exc)
-        }
+        bridgeExecutor.updateState(StateChange.Context(context))
     }
 
     @ReactMethod
     fun addMetadata(section: String, data: ReadableMap?) {
+        bridgeExecutor.updateState(StateChange.AddMetadata(section).apply {
+            values.add { data?.toHashMap() as Map<String, Any?>? }
+        })
+    }
+
+    /**
+     * Applies a context, user or metadata change, which may combine several consecutive calls.
+     */
+    internal fun applyStateChange(change: StateChange) {
+        when (change) {
+            is StateChange.Context -> try {
+                plugin.updateContext(change.context)
+            } catch (exc: Throwable) {
+                logFailure("updateContext", exc)
+            }
+            is StateChange.User -> try {
+                plugin.updateUser(change.id, change.email, change.name)
+            } catch (exc: Throwable) {
+                logFailure("updateUser", exc)
+            }
+            is StateChange.AddMetadata -> try {
+                for (values in coalesceMetadata(change.values.map { it() })) {
+                    plugin.addMetadata(change.section, values)
+                }
+            } catch (exc: Throwable) {
+                logFailure("addMetadata", exc)
+            }
+        }
+    }
+
+    @ReactMethod
+    fun updateMetadata(
+        section: String,
+        values: ReadableMap?,
+        removedKeys: ReadableArray?
+    ) = bridgeExecutor.execute("updateMetadata") {
         try {
-          plugin.addMetadata(section, data?.toHashMap() as Map<String, Any?>?)
+            removedKeys?.toArrayList()?.forEach { key ->
+                plugin.clearMetadata(section, key as String)
+            }
+            if (values != null) {
+                plugin.addMetadata(section, values.toHashMap() as Map<String, Any?>)
+            }
         } catch (exc: Throwable) {
-            logFailure("addMetadata", exc)
+            logFailure("updateMetadata", exc)
         }
     }
 
     @ReactMethod
-    fun clearMetadata(section: String, key: String?) {
+    fun clearMetadata(section: String, key: String?) = bridgeExecutor.execute("clearMetadata") {
         try {
             plugin.clearMetadata(section, key)
         } catch (exc: Throwable) {
@@ -154,17 +341,59 @@ class BugsnagReactNative(private val reactContext: ReactApplicationContext) :
 
     @ReactMethod
     fun updateUser(id: String?, email: String?, name: String?) {
+        bridgeExecutor.updateState(StateChange.User(id, email, name))
+    }
+
+    /**
+     * Applies a batch of context, user and metadata changes, in order, each described by a map
+     * with a "type" and the arguments of the method that would otherwise have been called.
+     */
+    @ReactMethod
+    fun applyStateChanges(changes: ReadableArray) = bridgeExecutor.execute("applyStateChanges") {
+        applyStateChangeList(changes.toArrayList())
+    }
+
+    /**
+     * As [applyStateChanges], for changes that were encoded as JSON by JS.
+     */
+    @ReactMethod
+    fun applyStateChangesJSON(json: String) = bridgeExecutor.execute("applyStateChangesJSON") {
         try {
-            plugin.updateUser(id, email, name)
+            applyStateChangeList(JsonDecoder(json).decodeArray())
         } catch (exc: Throwable) {
-            logFailure("updateUser", exc)
+            logFailure("applyStateChangesJSON", exc)
+        }
+    }
+
+    @Suppress("UNCHECKED_CAST")
+    private fun applyStateChangeList(changes: List<Any?>) {
+        for (change in changes) {
+            try {
+                val map = change as? Map<String, Any?> ?: continue
+                val section = map["section"] as String?
+                when (map["type"]) {
+                    "context" -> plugin.updateContext(map["context"] as String?)
+                    "user" -> plugin.updateUser(map["id"] as String?, map["email"] as String?, map["name"] as String?)
+                    "addMetadata" -> plugin.addMetadata(section!!, map["data"] as Map<String, Any?>?)
+                    "updateMetadata" -> {
+                        (map["removedKeys"] as List<Any?>?)?.forEach { key ->
+                            plugin.clearMetadata(section!!, key as String)
+                        }
+                        (map["values"] as Map<String, Any?>?)?.let { plugin.addMetadata(section!!, it) }
+                    }
+                    "clearMetadata" -> plugin.clearMetadata(section!!, map["key"] as String?)
+                    else -> logger.w("Received unknown state change ${map["type"]}, ignoring")
+                }
+            } catch (exc: Throwable) {
+                logFailure("applyStateChanges", exc)
+            }
         }
     }
 
     @ReactMethod
-    fun dispatch(payload: ReadableMap, promise: Promise) {
+    fun dispatch(payload: ReadableMap, promise: Promise) = bridgeExecutor.execute("dispatch") {
         try {
-            plugin.dispatch(payload.toHashMap())
+            plugin.dispatch(enrichPayload(payload.toHashMap()))
             promise.resolve(true)
         } catch (exc: Throwable) {
             logFailure("dispatch", exc)
@@ -172,12 +401,52 @@ class BugsnagReactNative(private val reactContext: ReactApplicationContext) :
         }
     }
 
+    /**
+     * Dispatches an event that was encoded as JSON by JS, which crosses the bridge as a single
+     * string and is decoded in one pass, rather than as a [ReadableMap] that has to be converted.
+     */
+    @ReactMethod
+    fun dispatchJSON(json: String, promise: Promise) = bridgeExecutor.execute("dispatchJSON") {
+        try {
+            plugin.dispatch(enrichPayload(JsonDecoder(json).decodeObject()))
+            promise.resolve(true)
+        } catch (exc: Throwable) {
+            logFailure("dispatchJSON", exc)
+            promise.resolve(false)
+        }
+    }
+
+    /**
+     * Attaches the native app, device, breadcrumbs and threads to a payload that JS marked for
+     * native enrichment. Anything JS callbacks set is kept, and takes precedence over native values.
+     */
+    @Suppress("UNCHECKED_CAST")
+    private fun enrichPayload(payload: Map<String, Any?>): Map<String, Any?> {
+        if (payload[NATIVE_ENRICHMENT_KEY] != true) {
+            return payload
+        }
+        val unhandled = payload["unhandled"] as? Boolean ?: false
+        val info = plugin.getPayloadInfo(unhandled)
+        val enriched = HashMap(payload)
+        enriched.remove(NATIVE_ENRICHMENT_KEY)
+        for (key in listOf("app", "device")) {
+            val native = info[key] as? Map<String, Any?> ?: continue
+            val fromJS = payload[key] as? Map<String, Any?>
+            enriched[key] = if (fromJS.isNullOrEmpty()) native else native + fromJS
+        }
+        // Any breadcrumbs in the payload were added to the event by JS callbacks.
+        val breadcrumbs = info["breadcrumbs"] as? List<Any?> ?: emptyList()
+        enriched["breadcrumbs"] = breadcrumbs + (payload["breadcrumbs"] as? List<Any?> ?: emptyList())
+        enriched["threads"] = info["threads"]
+        return enriched
+    }
+
     @ReactMethod
-    fun getPayloadInfo(payload: ReadableMap, promise: Promise) {
+    fun getPayloadInfo(payload: ReadableMap, promise: Promise) = bridgeExecutor.execute("getPayloadInfo") {
         try {
             val unhandled = payload.getBoolean("unhandled")
             val info = plugin.getPayloadInfo(unhandled)
-            promise.resolve(Arguments.makeNativeMap(info))
+            promise.resolve(info.toWritableMap())
         } catch (exc: Throwable) {
             logFailure("getPayloadInfo", exc)
         }
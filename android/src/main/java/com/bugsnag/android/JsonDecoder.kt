@@ -0,0 +1,159 @@
+package com.bugsnag.android
+
+/**
+ * Decodes JSON into the maps, lists, strings, numbers and booleans that
+ * [com.facebook.react.bridge.ReadableMap.toHashMap] would have produced for it, without building a
+ * [com.facebook.react.bridge.ReadableMap] or an intermediate `org.json` tree. Numbers are doubles,
+ * as they are in JS.
+ */
+internal class JsonDecoder(private val json: String) {
+
+    private var pos = 0
+
+    fun decodeObject(): Map<String, Any?> = decode { readObject() }
+
+    fun decodeArray(): List<Any?> = decode { readArray() }
+
+    private fun <T> decode(read: () -> T): T {
+        skipWhitespace()
+        val value = read()
+        skipWhitespace()
+        if (pos != json.length) {
+            throw IllegalArgumentException("Unexpected data after JSON value at $pos")
+        }
+        return value
+    }
+
+    private fun readValue(): Any? {
+        skipWhitespace()
+        return when (peek()) {
+            '{' -> readObject()
+            '[' -> readArray()
+            '"' -> readString()
+            't' -> readLiteral("true", true)
+            'f' -> readLiteral("false", false)
+            'n' -> readLiteral("null", null)
+            else -> readNumber()
+        }
+    }
+
+    private fun readObject(): HashMap<String, Any?> {
+        expect('{')
+        val map = HashMap<String, Any?>()
+        skipWhitespace()
+        if (peek() == '}') {
+            pos++
+            return map
+        }
+        while (true) {
+            skipWhitespace()
+            val key = readString()
+            skipWhitespace()
+            expect(':')
+            map[key] = readValue()
+            skipWhitespace()
+            if (next() == '}') {
+                return map
+            }
+            pos--
+            expect(',')
+        }
+    }
+
+    private fun readArray(): ArrayList<Any?> {
+        expect('[')
+        val list = ArrayList<Any?>()
+        skipWhitespace()
+        if (peek() == ']') {
+            pos++
+            return list
+        }
+        while (true) {
+            list.add(readValue())
+            skipWhitespace()
+            if (next() == ']') {
+                return list
+            }
+            pos--
+            expect(',')
+        }
+    }
+
+    private fun readString(): String {
+        expect('"')
+        val start = pos
+        // Most strings have no escapes, and can be taken as a substring.
+        while (pos < json.length) {
+            when (json[pos]) {
+                '"' -> return json.substring(start, pos++)
+                '\\' -> return readEscapedString(StringBuilder().append(json, start, pos))
+                else -> pos++
+            }
+        }
+        throw IllegalArgumentException("Unterminated string at $start")
+    }
+
+    private fun readEscapedString(builder: StringBuilder): String {
+        while (true) {
+            when (val char = next()) {
+                '"' -> return builder.toString()
+                '\\' -> when (val escaped = next()) {
+                    'b' -> builder.append('\b')
+                    'f' -> builder.append('\u000C')
+                    'n' -> builder.append('\n')
+                    'r' -> builder.append('\r')
+                    't' -> builder.append('\t')
+                    'u' -> {
+                        if (pos + 4 > json.length) {
+                            throw IllegalArgumentException("Invalid unicode escape at $pos")
+                        }
+                        builder.append(json.substring(pos, pos + 4).toInt(16).toChar())
+                        pos += 4
+                    }
+                    else -> builder.append(escaped)
+                }
+                else -> builder.append(char)
+            }
+        }
+    }
+
+    private fun readNumber(): Double {
+        val start = pos
+        while (pos < json.length && json[pos] in "+-0123456789.eE") {
+            pos++
+        }
+        if (start == pos) {
+            throw IllegalArgumentException("Unexpected character at $pos")
+        }
+        return json.substring(start, pos).toDouble()
+    }
+
+    private fun readLiteral(literal: String, value: Any?): Any? {
+        if (!json.startsWith(literal, pos)) {
+            throw IllegalArgumentException("Unexpected character at $pos")
+        }
+        pos += literal.length
+        return value
+    }
+
+    private fun skipWhitespace() {
+        while (pos < json.length && json[pos].isWhitespace()) {
+            pos++
+        }
+    }
+
+    private fun peek(): Char {
+        if (pos >= json.length) {
+            throw IllegalArgumentException("Unexpected end of JSON")
+        }
+        return json[pos]
+    }
+
+    private fun next(): Char = peek().also { pos++ }
+
+    private fun expect(char: Char) {
+        if (next() != char) {
+            throw IllegalArgumentException("Expected '$char' at ${pos - 1}")
+        }
+    }
+}
@@ -1,26 +1,50 @@
 package com.bugsnag.android
 
-import com.facebook.react.bridge.Arguments
+import com.facebook.react.bridge.WritableArray
 import com.facebook.react.bridge.WritableMap
+import com.facebook.react.bridge.WritableNativeArray
 import com.facebook.react.bridge.WritableNativeMap
 
-@Suppress("UNCHECKED_CAST")
+/**
+ * Converts the map into a native map for the bridge. Nested maps and collections are converted by
+ * type directly, rather than through [com.facebook.react.bridge.Arguments], which copies every
+ * collection into an array and dispatches on each element's class reflectively.
+ */
 internal fun Map<String, Any?>.toWritableMap(): WritableMap {
     val nativeMap = WritableNativeMap()
-
-    entries.forEach {
-        val key = it.key
-        when (val obj = it.value) {
+    for ((key, obj) in this) {
+        when (obj) {
             null -> nativeMap.putNull(key)
             is Boolean -> nativeMap.putBoolean(key, obj)
             is Int -> nativeMap.putInt(key, obj)
-            is Long -> nativeMap.putDouble(key, obj.toDouble())
             is Number -> nativeMap.putDouble(key, obj.toDouble())
             is String -> nativeMap.putString(key, obj)
-            is Map<*, *> -> nativeMap.putMap(key, Arguments.makeNativeMap(obj as MutableMap<String, Any>))
-            is Collection<*> ->  nativeMap.putArray(key, Arguments.makeNativeArray<Any>(obj.toTypedArray()))
+            is Map<*, *> -> nativeMap.putMap(key, obj.toWritableMapUnchecked())
+            is Collection<*> -> nativeMap.putArray(key, obj.toWritableArray())
+            is Array<*> -> nativeMap.putArray(key, obj.asList().toWritableArray())
             else -> throw IllegalArgumentException("Could not convert $obj to native map")
         }
     }
     return nativeMap
 }
+
+internal fun Collection<*>.toWritableArray(): WritableArray {
+    val nativeArray = WritableNativeArray()
+    for (obj in this) {
+        when (obj) {
+            null -> nativeArray.pushNull()
+            is Boolean -> nativeArray.pushBoolean(obj)
+            is Int -> nativeArray.pushInt(obj)
+            is Number -> nativeArray.pushDouble(obj.toDouble())
+            is String -> nativeArray.pushString(obj)
+            is Map<*, *> -> nativeArray.pushMap(obj.toWritableMapUnchecked())
+            is Collection<*> -> nativeArray.pushArray(obj.toWritableArray())
+            is Array<*> -> nativeArray.pushArray(obj.asList().toWritableArray())
+            else -> throw IllegalArgumentException("Could not convert $obj to native array")
+        }
+    }
+    return nativeArray
+}
+
+@Suppress("UNCHECKED_CAST")
+private fun Map<*, *>.toWritableMapUnchecked() = (this as Map<String, Any?>).toWritableMap()
@@ -2,7 +2,9 @@ package com.bugsnag.android
 
 import com.facebook.react.bridge.Promise
 import com.facebook.react.bridge.ReactApplicationContext
+import com.facebook.react.bridge.ReadableArray
 import com.facebook.react.bridge.ReadableMap
+import com.facebook.react.bridge.ReadableType
 import org.junit.Assert.assertEquals
 import org.junit.Before
 import org.junit.Test
@@ -10,9 +12,13 @@ import org.junit.runner.RunWith
 import org.mockito.Mock
 import org.mockito.Mockito.`when`
 import org.mockito.Mockito.any
+import org.mockito.Mockito.anyInt
+import org.mockito.Mockito.inOrder
+import org.mockito.Mockito.never
 import org.mockito.Mockito.times
 import org.mockito.Mockito.verify
 import org.mockito.junit.MockitoJUnitRunner
+import java.util.concurrent.Executor
 
 @RunWith(MockitoJUnitRunner::class)
 class BugsnagReactNativeTest {
@@ -26,6 +32,9 @@ class BugsnagReactNativeTest {
     @Mock
     lateinit var map: ReadableMap
 
+    @Mock
+    lateinit var array: ReadableArray
+
     @Mock
     lateinit var promise: Promise
 
@@ -36,6 +45,7 @@ class BugsnagReactNativeTest {
         brn = BugsnagReactNative(ctx)
         brn.plugin = plugin
         brn.logger = object: Logger {}
+        brn.bridgeExecutor = BridgeExecutor(Executor { it.run() }, brn::applyStateChange)
         `when`(map.toHashMap()).thenReturn(HashMap())
     }
 
@@ -50,6 +60,15 @@ class BugsnagReactNativeTest {
         verify(plugin, times(1)).leaveBreadcrumb(any())
     }
 
+    @Test
+    fun leaveBreadcrumbs() {
+        `when`(array.size()).thenReturn(2)
+        `when`(array.getType(anyInt())).thenReturn(ReadableType.Map)
+        `when`(array.getMap(anyInt())).thenReturn(map)
+        brn.leaveBreadcrumbs(array)
+        verify(plugin, times(2)).leaveBreadcrumb(any())
+    }
+
     @Test
     fun startSession() {
         brn.startSession()
@@ -68,6 +87,31 @@ class BugsnagReactNativeTest {
         verify(plugin, times(1)).resumeSession()
     }
 
+    @Test
+    fun updateMetadata() {
+        `when`(array.toArrayList()).thenReturn(arrayListOf<Any?>("foo", "bar"))
+        brn.updateMetadata("custom", map, array)
+        verify(plugin, times(2)).clearMetadata(any(), any())
+        verify(plugin, times(1)).addMetadata(any(), any())
+    }
+
+    @Test
+    fun applyStateChanges() {
+        `when`(array.toArrayList()).thenReturn(arrayListOf<Any?>(
+            hashMapOf("type" to "context", "context" to "Foo"),
+            hashMapOf("type" to "user", "id" to "123", "email" to null, "name" to "Joe"),
+            hashMapOf("type" to "updateMetadata", "section" to "custom",
+                "values" to hashMapOf("a" to 1), "removedKeys" to arrayListOf("b")),
+            hashMapOf("type" to "clearMetadata", "section" to "custom", "key" to null)
+        ))
+        brn.applyStateChanges(array)
+        verify(plugin, times(1)).updateContext("Foo")
+        verify(plugin, times(1)).updateUser("123", null, "Joe")
+        verify(plugin, times(1)).clearMetadata("custom", "b")
+        verify(plugin, times(1)).addMetadata("custom", mapOf("a" to 1))
+        verify(plugin, times(1)).clearMetadata("custom", null)
+    }
+
     @Test
     fun updateContext() {
         brn.updateContext("Foo")
@@ -80,12 +124,92 @@ class BugsnagReactNativeTest {
         verify(plugin, times(1)).updateUser("123", "joe@example.com", "Joe")
     }
 
+    @Test
+    fun coalesceStateChanges() {
+        val queued = mutableListOf<Runnable>()
+        brn.bridgeExecutor = BridgeExecutor(Executor { queued.add(it) }, brn::applyStateChange)
+        `when`(map.toHashMap()).thenReturn(hashMapOf<String, Any?>("a" to 1), hashMapOf<String, Any?>("b" to 2))
+        brn.updateContext("Foo")
+        brn.updateContext("Bar")
+        brn.updateUser("1", null, null)
+        brn.updateUser("2", null, "Joe")
+        brn.addMetadata("custom", map)
+        brn.addMetadata("custom", map)
+        brn.startSession()
+        brn.updateContext("Baz")
+        assertEquals(3, queued.size)
+        queued.forEach { it.run() }
+        val order = inOrder(plugin)
+        order.verify(plugin).updateContext("Bar")
+        order.verify(plugin).updateUser("2", null, "Joe")
+        order.verify(plugin).addMetadata("custom", mapOf("a" to 1, "b" to 2))
+        order.verify(plugin).startSession()
+        order.verify(plugin).updateContext("Baz")
+        verify(plugin, never()).updateContext("Foo")
+        verify(plugin, never()).updateUser("1", null, null)
+    }
+
+    @Test
+    fun coalesceMetadataKeepsNestedMapsSeparate() {
+        val values = listOf<Map<String, Any?>?>(
+            mapOf("a" to 1), mapOf("b" to 2), mapOf("n" to mapOf("x" to 1)), mapOf("n" to mapOf("y" to 2)), null
+        )
+        assertEquals(listOf(mapOf("a" to 1, "b" to 2, "n" to mapOf("x" to 1)), mapOf("n" to mapOf("y" to 2)), null),
+            coalesceMetadata(values))
+    }
+
     @Test
     fun dispatch() {
         brn.dispatch(map, promise)
         verify(plugin, times(1)).dispatch(any())
     }
 
+    @Test
+    fun dispatchWithNativeEnrichment() {
+        `when`(plugin.getPayloadInfo(false)).thenReturn(mapOf(
+            "app" to mapOf("id" to "com.example", "version" to "1.0"),
+            "device" to mapOf("id" to "123"),
+            "breadcrumbs" to listOf("native"),
+            "threads" to listOf("main")
+        ))
+        `when`(map.toHashMap()).thenReturn(hashMapOf(
+            "nativeEnrichment" to true,
+            "unhandled" to false,
+            "app" to mapOf("version" to "2.0"),
+            "device" to emptyMap<String, Any?>(),
+            "breadcrumbs" to listOf("js"),
+            "threads" to emptyList<Any?>()
+        ))
+        brn.dispatch(map, promise)
+        verify(plugin, times(1)).dispatch(mapOf(
+            "unhandled" to false,
+            "app" to mapOf("id" to "com.example", "version" to "2.0"),
+            "device" to mapOf("id" to "123"),
+            "breadcrumbs" to listOf("native", "js"),
+            "threads" to listOf("main")
+        ))
+    }
+
+    @Test
+    fun dispatchJSON() {
+        val json = """{"errors":[{"errorClass":"Error","stacktrace":[]}],
+            "metadata":{"a":{"b":1.5,"c":"\"xé\"","d":[true,null],"e":"\u00e9"}},"unhandled":false}"""
+        brn.dispatchJSON(json, promise)
+        verify(plugin, times(1)).dispatch(mapOf(
+            "errors" to listOf(mapOf("errorClass" to "Error", "stacktrace" to emptyList<Any>())),
+            "metadata" to mapOf("a" to mapOf("b" to 1.5, "c" to "\"xé\"", "d" to listOf(true, null), "e" to "é")),
+            "unhandled" to false
+        ))
+        verify(promise, times(1)).resolve(true)
+    }
+
+    @Test
+    fun dispatchInvalidJSON() {
+        brn.dispatchJSON("{\"errors\":", promise)
+        verify(plugin, times(0)).dispatch(any())
+        verify(promise, times(1)).resolve(false)
+    }
+
     @Test
     fun getPayloadInfo() {
         brn.getPayloadInfo(map, promise)
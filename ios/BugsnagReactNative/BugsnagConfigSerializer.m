@@ -26,6 +26,9 @@
     dict[@"enabledBreadcrumbTypes"] = [self serializeBreadcrumbTypes:config];
     dict[@"enabledErrorTypes"] = [self serializeErrorTypes:config];
     dict[@"endpoints"] = [self serializeEndpoints:config];
+    // Tells JS not to instrument XMLHttpRequest and fetch, since their requests are recorded natively.
+    dict[@"nativeNetworkBreadcrumbs"] = @(config.recordNetworkBreadcrumbs &&
+                                          (config.enabledBreadcrumbTypes & BSGEnabledBreadcrumbTypeRequest));
 
     return [NSDictionary dictionaryWithDictionary:dict];
 }
@@ -14,6 +14,11 @@ NS_ASSUME_NONNULL_BEGIN
 
 @interface BugsnagEventDeserializer : NSObject
 
+/// Records the running session and, if the payload asks for native enrichment, the native app, device, breadcrumbs
+/// and threads, so that an event deserialized later on another queue reflects the state when the error happened.
+/// Otherwise they are recorded by deserializeEvent:.
+- (void)captureNativeStateForPayload:(NSDictionary *)payload;
+
 - (BugsnagEvent *)deserializeEvent:(NSDictionary *)payload;
 
 @end
@@ -11,6 +11,7 @@
 #import "Bugsnag+Private.h"
 #import "BugsnagAppWithState+Private.h"
 #import "BugsnagBreadcrumb+Private.h"
+#import "BugsnagBreadcrumbs.h"
 #import "BugsnagClient+Private.h"
 #import "BugsnagDeviceWithState+Private.h"
 #import "BugsnagError+Private.h"
@@ -22,24 +23,77 @@
 #import "BugsnagThread+Private.h"
 #import "BugsnagUser+Private.h"
 
-@implementation BugsnagEventDeserializer
+/// Set by JS when it skipped getPayloadInfo, so native must attach the app, device, breadcrumbs and threads itself.
+static NSString * const NativeEnrichmentKey = @"nativeEnrichment";
 
-- (BugsnagEvent *)deserializeEvent:(NSDictionary *)payload {
+/// Returns the native values overlaid with any that JS set.
+static NSDictionary * BSGMergeNativeState(NSDictionary *native, id fromJS) {
+    if (![fromJS isKindOfClass:[NSDictionary class]] || ![fromJS count]) {
+        return native;
+    }
+    NSMutableDictionary *merged = [native mutableCopy];
+    [merged addEntriesFromDictionary:fromJS];
+    return merged;
+}
+
+@implementation BugsnagEventDeserializer {
+    BOOL _captured;
+    BugsnagSession *_session;
+    NSDictionary *_app;
+    NSDictionary *_device;
+    NSArray<BugsnagBreadcrumb *> *_breadcrumbs;
+    NSArray<BugsnagThread *> *_threads;
+}
+
+- (void)captureNativeStateForPayload:(NSDictionary *)payload {
+    [self captureNativeStateForPayload:payload depth:1]; // discard -captureNativeStateForPayload:
+}
+
+- (void)captureNativeStateForPayload:(NSDictionary *)payload depth:(int)depth {
     BugsnagClient *client = [Bugsnag client];
-    BugsnagSession *session = client.sessionTracker.runningSession;
+    _captured = YES;
+    _session = client.sessionTracker.runningSession;
+    if ([payload[NativeEnrichmentKey] boolValue]) {
+        _app = [client collectAppWithState];
+        _device = [client collectDeviceWithState];
+        _breadcrumbs = client.breadcrumbs.breadcrumbs;
+        // discard -captureNativeStateForPayload:depth: and its callers
+        _threads = [client captureThreads:[self deserializeHandledState:payload].unhandled depth:depth + 1];
+    }
+}
+
+- (BugsnagEvent *)deserializeEvent:(NSDictionary *)payload {
+    if (!_captured) {
+        [self captureNativeStateForPayload:payload depth:1]; // discard -deserializeEvent:
+    }
+    BugsnagSession *session = _session;
     BugsnagMetadata *metadata = [[BugsnagMetadata alloc] initWithDictionary:payload[@"metadata"]];
 
     BugsnagHandledState *handledState = [self deserializeHandledState:payload];
     NSDictionary *user = payload[@"user"];
 
-    BugsnagEvent *event = [[BugsnagEvent alloc] initWithApp:[BugsnagAppWithState appFromJson:payload[@"app"]]
-                                                     device:[BugsnagDeviceWithState deviceFromJson:payload[@"device"]]
+    NSDictionary *app = payload[@"app"];
+    NSDictionary *device = payload[@"device"];
+    NSArray<BugsnagBreadcrumb *> *breadcrumbs = [self deserializeBreadcrumbs:payload[@"breadcrumbs"]];
+    NSArray<BugsnagThread *> *threads;
+    if ([payload[NativeEnrichmentKey] boolValue]) {
+        app = BSGMergeNativeState(_app, app);
+        device = BSGMergeNativeState(_device, device);
+        // Any breadcrumbs in the payload were added to the event by JS callbacks.
+        breadcrumbs = [_breadcrumbs ?: @[] arrayByAddingObjectsFromArray:breadcrumbs];
+        threads = _threads;
+    } else {
+        threads = [self deserializeThreads:payload[@"threads"]];
+    }
+
+    BugsnagEvent *event = [[BugsnagEvent alloc] initWithApp:[BugsnagAppWithState appFromJson:app]
+                                                     device:[BugsnagDeviceWithState deviceFromJson:device]
                                                handledState:handledState
                                                        user:[[BugsnagUser alloc] initWithDictionary:user]
                                                    metadata:metadata
-                                                breadcrumbs:[self deserializeBreadcrumbs:payload[@"breadcrumbs"]]
+                                                breadcrumbs:breadcrumbs
                                                      errors:@[[BugsnagError new]]
-                                                    threads:[self deserializeThreads:payload[@"threads"]]
+                                                    threads:threads
                                                     session:session];
     event.context = payload[@"context"];
     event.groupingHash = payload[@"groupingHash"];
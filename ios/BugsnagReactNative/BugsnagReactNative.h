@@ -4,6 +4,7 @@
 #import <React/RCTBridge.h>
 
 @class BugsnagConfiguration;
+@class BugsnagEventDeserializer;
 
 @interface BugsnagReactNative: NSObject<RCTBridgeModule>
 
@@ -13,6 +14,8 @@
 
 - (NSDictionary *)configure:(NSDictionary *)readableMap;
 
+- (void)configureNotifier:(NSDictionary *)readableMap;
+
 - (void)updateCodeBundleId:(NSString *)codeBundleId;
 
 - (void)addMetadata:(NSString *)section
@@ -21,6 +24,10 @@
 - (void)clearMetadata:(NSString *)section
               withKey:(NSDictionary *)key;
 
+- (void)updateMetadata:(NSString *)section
+            withValues:(NSDictionary *)values
+           removedKeys:(NSArray *)removedKeys;
+
 - (void)updateContext:(NSString *)context;
 
 - (void)updateUser:(NSString *)userId
@@ -41,4 +48,14 @@
 
 - (void)leaveBreadcrumb:(NSDictionary *)options;
 
+- (void)leaveBreadcrumbs:(NSArray *)batch;
+
+- (NSNumber *)installJSI;
+
+- (void)dispatchPayload:(NSDictionary *)payload;
+
+/// Builds the event with a deserializer that may already have captured the native state, as when the payload is
+/// received on another thread.
+- (void)dispatchPayload:(NSDictionary *)payload deserializer:(BugsnagEventDeserializer *)deserializer;
+
 @end
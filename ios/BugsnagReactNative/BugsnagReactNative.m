@@ -1,26 +1,117 @@
 #import "BugsnagReactNative.h"
 
+#import <React/RCTBridge+Private.h>
+
+#import "BSGJSONSerialization.h"
+#import "BSG_KSCrashC.h"
+#import "BSG_KSMach.h"
+#import "BSGSignposts.h"
 #import "Bugsnag+Private.h"
+#import "BugsnagClient+AppHangs.h"
 #import "BugsnagClient+Private.h"
 #import "BugsnagReactNativeEmitter.h"
+#import "BugsnagReactNativeJSI.h"
 #import "BugsnagConfigSerializer.h"
 #import "BugsnagEventDeserializer.h"
+#import "BugsnagLogger.h"
 
 @interface BugsnagReactNative ()
 @property (nonatomic) BugsnagConfigSerializer *configSerializer;
+@property (nonatomic) dispatch_group_t serializedConfigGroup;
+@property (nonatomic) NSDictionary *serializedConfig;
 @end
 
 @implementation BugsnagReactNative
 
+@synthesize bridge = _bridge;
+
 RCT_EXPORT_MODULE()
 
++ (BOOL)requiresMainQueueSetup {
+    return NO;
+}
+
+- (instancetype)init {
+    if ((self = [super init])) {
+        // Serialize the configuration as soon as the bridge creates the module, so
+        // that JS can read it from the module's constants rather than waiting on a
+        // synchronous configure() call. Bugsnag must have been started by now.
+        _serializedConfigGroup = dispatch_group_create();
+        if ([Bugsnag bugsnagStarted]) {
+            BugsnagConfiguration *config = [Bugsnag configuration];
+            dispatch_group_async(_serializedConfigGroup, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^{
+                self.serializedConfig = [[BugsnagConfigSerializer new] serialize:config];
+            });
+        }
+    }
+    return self;
+}
+
+- (NSDictionary *)constantsToExport {
+    dispatch_group_wait(self.serializedConfigGroup, DISPATCH_TIME_FOREVER);
+    // enrichesPayloads tells JS that dispatched events can omit what getPayloadInfo would provide.
+    NSMutableDictionary *constants = [NSMutableDictionary dictionaryWithObject:@YES forKey:@"enrichesPayloads"];
+    constants[@"configuration"] = self.serializedConfig;
+    return constants;
+}
+
+// Called from JS at startup. When this returns true, global.__bugsnagNativeClient
+// is used for the frequent calls instead of the bridge.
+RCT_EXPORT_BLOCKING_SYNCHRONOUS_METHOD(installJSI) {
+    return @(BSGInstallJSIBindings(self, self.bridge));
+}
+
 RCT_EXPORT_METHOD(configureAsync:(NSDictionary *)readableMap
                          resolve:(RCTPromiseResolveBlock)resolve
                           reject:(RCTPromiseRejectBlock)reject) {
-    resolve([self configure:readableMap]);
+    [self registerJavaScriptThreadAsync];
+    resolve([self configureWithOptions:readableMap]);
 }
 
 RCT_EXPORT_BLOCKING_SYNCHRONOUS_METHOD(configure:(NSDictionary *)readableMap) {
+    // Synchronous methods are called on the JavaScript thread.
+    [BugsnagReactNative registerJavaScriptThread];
+    return [self configureWithOptions:readableMap];
+}
+
+// Used with the configuration from the module's constants. Only records the JS
+// notifier's details, so nothing waits for it.
+RCT_EXPORT_METHOD(configureNotifier:(NSDictionary *)readableMap) {
+    [self updateNotifierInfo:readableMap];
+    [self addRuntimeVersionInfo:readableMap];
+    // JS applies its own changes before sending them, so does not need them echoed back.
+    BugsnagReactNativeEmitter.suppressesChangesFromJS = [readableMap[@"suppressSyncEchoes"] boolValue];
+    [self registerJavaScriptThreadAsync];
+}
+
+/// Registers the JavaScript thread, from the thread itself, when called from another one.
+- (void)registerJavaScriptThreadAsync {
+    RCTBridge *bridge = self.bridge;
+    if ([bridge respondsToSelector:@selector(dispatchBlock:queue:)]) {
+        [bridge dispatchBlock:^{
+            [BugsnagReactNative registerJavaScriptThread];
+        } queue:RCTJSThread];
+    }
+}
+
+/// Makes the calling JavaScript thread one that is always included in crash reports, and whose hangs are
+/// reported, in place of any thread that was used before the JS was reloaded. Does nothing if it already is.
++ (void)registerJavaScriptThread {
+    static thread_t javaScriptThread = MACH_PORT_NULL;
+    const thread_t thread = bsg_ksmachthread_self();
+    @synchronized (self) {
+        if (thread != javaScriptThread) {
+            if (javaScriptThread != MACH_PORT_NULL) {
+                bsg_kscrash_removePriorityThread(javaScriptThread);
+            }
+            bsg_kscrash_addPriorityThread(thread);
+            javaScriptThread = thread;
+        }
+    }
+    [[Bugsnag client] startHangDetectorForCurrentThread];
+}
+
+- (NSDictionary *)configureWithOptions:(NSDictionary *)readableMap {
     self.configSerializer = [BugsnagConfigSerializer new];
 
     if (![Bugsnag bugsnagStarted]) {
@@ -28,6 +119,8 @@ RCT_EXPORT_BLOCKING_SYNCHRONOUS_METHOD(configure:(NSDictionary *)readableMap) {
     }
     [self updateNotifierInfo:readableMap];
     [self addRuntimeVersionInfo:readableMap];
+    // JS applies its own changes before sending them, so does not need them echoed back.
+    BugsnagReactNativeEmitter.suppressesChangesFromJS = [readableMap[@"suppressSyncEchoes"] boolValue];
 
     BugsnagConfiguration *config = [Bugsnag configuration];
     return [self.configSerializer serialize:config];
@@ -35,20 +128,36 @@ RCT_EXPORT_BLOCKING_SYNCHRONOUS_METHOD(configure:(NSDictionary *)readableMap) {
 
 RCT_EXPORT_METHOD(addMetadata:(NSString *)section
                      withData:(NSDictionary *)data) {
-    [Bugsnag addMetadata:data toSection:section];
+    uint64_t signpost = BSGSignpostBeginWithDetail(BSGSignpostBridgeCall, "addMetadata");
+    [BugsnagReactNativeEmitter performChangeFromJS:^{
+        [Bugsnag addMetadata:data toSection:section];
+    }];
+    BSGSignpostEnd(BSGSignpostBridgeCall, signpost);
+}
+
+RCT_EXPORT_METHOD(updateMetadata:(NSString *)section
+                      withValues:(NSDictionary *)values
+                     removedKeys:(NSArray *)removedKeys) {
+    [BugsnagReactNativeEmitter performChangeFromJS:^{
+        [[Bugsnag client].metadata updateSection:section withValues:values removingKeys:removedKeys];
+    }];
 }
 
 RCT_EXPORT_METHOD(clearMetadata:(NSString *)section
                      withKey:(NSString *)key) {
-    if (key == nil) {
-        [Bugsnag clearMetadataFromSection:section];
-    } else {
-        [Bugsnag clearMetadataFromSection:section withKey:key];
-    }
+    [BugsnagReactNativeEmitter performChangeFromJS:^{
+        if (key == nil) {
+            [Bugsnag clearMetadataFromSection:section];
+        } else {
+            [Bugsnag clearMetadataFromSection:section withKey:key];
+        }
+    }];
 }
 
 RCT_EXPORT_METHOD(updateContext:(NSString *)context) {
-    [Bugsnag setContext:context];
+    [BugsnagReactNativeEmitter performChangeFromJS:^{
+        [Bugsnag setContext:context];
+    }];
 }
 
 RCT_EXPORT_METHOD(updateCodeBundleId:(NSString *)codeBundleId) {
@@ -58,31 +167,99 @@ RCT_EXPORT_METHOD(updateCodeBundleId:(NSString *)codeBundleId) {
 RCT_EXPORT_METHOD(updateUser:(NSString *)userId
                    withEmail:(NSString *)email
                     withName:(NSString *)name) {
-    [Bugsnag setUser:userId withEmail:email andName:name];
+    uint64_t signpost = BSGSignpostBeginWithDetail(BSGSignpostBridgeCall, "updateUser");
+    [BugsnagReactNativeEmitter performChangeFromJS:^{
+        [Bugsnag setUser:userId withEmail:email andName:name];
+    }];
+    BSGSignpostEnd(BSGSignpostBridgeCall, signpost);
+}
+
+// Applies a batch of context, user and metadata changes, in order, each described by a dictionary
+// with a "type" and the arguments of the method that would otherwise have been called.
+RCT_EXPORT_METHOD(applyStateChanges:(NSArray *)changes) {
+    uint64_t signpost = BSGSignpostBeginWithDetail(BSGSignpostBridgeCall, "applyStateChanges");
+    for (NSDictionary *change in changes) {
+        if (![change isKindOfClass:[NSDictionary class]]) {
+            continue;
+        }
+        id (^ argument)(NSString *) = ^id (NSString *key) {
+            id value = change[key];
+            return value == [NSNull null] ? nil : value;
+        };
+        NSString *type = argument(@"type");
+        if ([type isEqualToString:@"context"]) {
+            [self updateContext:argument(@"context")];
+        } else if ([type isEqualToString:@"user"]) {
+            [self updateUser:argument(@"id") withEmail:argument(@"email") withName:argument(@"name")];
+        } else if ([type isEqualToString:@"addMetadata"]) {
+            [self addMetadata:argument(@"section") withData:argument(@"data")];
+        } else if ([type isEqualToString:@"updateMetadata"]) {
+            [self updateMetadata:argument(@"section") withValues:argument(@"values") removedKeys:argument(@"removedKeys")];
+        } else if ([type isEqualToString:@"clearMetadata"]) {
+            [self clearMetadata:argument(@"section") withKey:argument(@"key")];
+        } else {
+            bsg_log_warn(@"Received unknown state change %@, ignoring", type);
+        }
+    }
+    BSGSignpostEnd(BSGSignpostBridgeCall, signpost);
 }
 
 RCT_EXPORT_METHOD(dispatch:(NSDictionary *)payload
                    resolve:(RCTPromiseResolveBlock)resolve
                     reject:(RCTPromiseRejectBlock)reject) {
-    BugsnagEventDeserializer *deserializer = [BugsnagEventDeserializer new];
+    uint64_t signpost = BSGSignpostBeginWithDetail(BSGSignpostBridgeCall, "dispatch");
+    [self dispatchPayload:payload];
+    resolve(@{});
+    BSGSignpostEnd(BSGSignpostBridgeCall, signpost);
+}
+
+// Receives the payload as a single string rather than as objects converted by the
+// bridge, and decodes it in one pass.
+RCT_EXPORT_METHOD(dispatchJSON:(NSString *)json
+                       resolve:(RCTPromiseResolveBlock)resolve
+                        reject:(RCTPromiseRejectBlock)reject) {
+    uint64_t signpost = BSGSignpostBeginWithDetail(BSGSignpostBridgeCall, "dispatchJSON");
+    NSData *data = [json dataUsingEncoding:NSUTF8StringEncoding];
+    NSError *error = nil;
+    id payload = data ? [BSGJSONSerialization JSONObjectWithData:data options:0 error:&error] : nil;
+    if ([payload isKindOfClass:[NSDictionary class]]) {
+        [self dispatchPayload:payload];
+        resolve(@{});
+    } else {
+        reject(@"dispatchJSON", @"Could not decode the event payload", error);
+    }
+    BSGSignpostEnd(BSGSignpostBridgeCall, signpost);
+}
+
+- (void)dispatchPayload:(NSDictionary *)payload {
+    [self dispatchPayload:payload deserializer:[BugsnagEventDeserializer new]];
+}
+
+- (void)dispatchPayload:(NSDictionary *)payload deserializer:(BugsnagEventDeserializer *)deserializer {
+    uint64_t signpost = BSGSignpostBegin(BSGSignpostEventDeserialization);
     BugsnagEvent *event = [deserializer deserializeEvent:payload];
+    BSGSignpostEnd(BSGSignpostEventDeserialization, signpost);
 
     [Bugsnag notifyInternal:event block:^BOOL(BugsnagEvent * _Nonnull event) {
         NSLog(@"Sending event from JS: %@", event);
         return true;
     }];
-    resolve(@{});
 }
 
 RCT_EXPORT_METHOD(leaveBreadcrumb:(NSDictionary *)options) {
-    NSString *message = options[@"message"];
-    if (message != nil) {
-        BSGBreadcrumbType type = [self breadcrumbTypeFromString:options[@"type"]];
-        NSDictionary *metadata = options[@"metadata"];
-        [Bugsnag leaveBreadcrumbWithMessage:message
-                                   metadata:metadata
-                                    andType:type];
+    uint64_t signpost = BSGSignpostBeginWithDetail(BSGSignpostBridgeCall, "leaveBreadcrumb");
+    [self leaveBreadcrumbWithOptions:options];
+    BSGSignpostEnd(BSGSignpostBridgeCall, signpost);
+}
+
+RCT_EXPORT_METHOD(leaveBreadcrumbs:(NSArray *)batch) {
+    uint64_t signpost = BSGSignpostBeginWithDetail(BSGSignpostBridgeCall, "leaveBreadcrumbs");
+    for (id options in batch) {
+        if ([options isKindOfClass:[NSDictionary class]]) {
+            [self leaveBreadcrumbWithOptions:options];
+        }
     }
+    BSGSignpostEnd(BSGSignpostBridgeCall, signpost);
 }
 
 RCT_EXPORT_METHOD(startSession) {
@@ -100,6 +277,7 @@ RCT_EXPORT_METHOD(resumeSession) {
 RCT_EXPORT_METHOD(getPayloadInfo:(NSDictionary *)options
                          resolve:(RCTPromiseResolveBlock)resolve
                           reject:(RCTPromiseRejectBlock)reject) {
+    uint64_t signpost = BSGSignpostBeginWithDetail(BSGSignpostBridgeCall, "getPayloadInfo");
     BugsnagClient *client = [Bugsnag client];
     NSMutableDictionary *info = [NSMutableDictionary new];
     info[@"app"] = [client collectAppWithState];
@@ -108,6 +286,18 @@ RCT_EXPORT_METHOD(getPayloadInfo:(NSDictionary *)options
     BOOL unhandled = [options[@"unhandled"] boolValue];
     info[@"threads"] = [client collectThreads:unhandled];
     resolve(info);
+    BSGSignpostEnd(BSGSignpostBridgeCall, signpost);
+}
+
+- (void)leaveBreadcrumbWithOptions:(NSDictionary *)options {
+    NSString *message = options[@"message"];
+    if (message != nil) {
+        BSGBreadcrumbType type = [self breadcrumbTypeFromString:options[@"type"]];
+        NSDictionary *metadata = options[@"metadata"];
+        [Bugsnag leaveBreadcrumbWithMessage:message
+                                   metadata:metadata
+                                    andType:type];
+    }
 }
 
 - (void)addRuntimeVersionInfo:(NSDictionary *)info {
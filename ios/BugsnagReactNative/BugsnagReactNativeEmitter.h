@@ -2,4 +2,11 @@
 #import <React/RCTEventEmitter.h>
 
 @interface BugsnagReactNativeEmitter : RCTEventEmitter <RCTBridgeModule>
+
+/// Whether changes made by `performChangeFromJS:` are not sent back to JS, which has already applied them.
+@property (class, atomic) BOOL suppressesChangesFromJS;
+
+/// Performs a change to the client's state that was requested by JS.
++ (void)performChangeFromJS:(dispatch_block_t)block;
+
 @end
@@ -1,19 +1,42 @@
 #import "BugsnagReactNativeEmitter.h"
 
+#import <stdatomic.h>
+
 #import "Bugsnag+Private.h"
 #import "BugsnagClient+Private.h"
 #import "BugsnagStateEvent.h"
 
 typedef void (^BugsnagObserverBlock)(BugsnagStateEvent *_Nonnull event);
 
+static atomic_bool BSGSuppressesChangesFromJS;
+
+/// Observers are called synchronously, on the thread that made the change.
+static __thread unsigned BSGChangesFromJSDepth;
+
 @interface BugsnagReactNativeEmitter ()
 @property BugsnagObserverBlock observerBlock;
+/// The latest change of each type that has not yet been sent. Must be accessed while synchronized on self.
+@property (nonatomic) NSMutableDictionary<NSString *, BugsnagStateEvent *> *pendingEvents;
 @end
 
 @implementation BugsnagReactNativeEmitter
 
 RCT_EXPORT_MODULE();
 
++ (BOOL)suppressesChangesFromJS {
+    return atomic_load(&BSGSuppressesChangesFromJS);
+}
+
++ (void)setSuppressesChangesFromJS:(BOOL)suppressesChangesFromJS {
+    atomic_store(&BSGSuppressesChangesFromJS, suppressesChangesFromJS);
+}
+
++ (void)performChangeFromJS:(dispatch_block_t)block {
+    BSGChangesFromJSDepth++;
+    block();
+    BSGChangesFromJSDepth--;
+}
+
 - (NSArray<NSString *> *)supportedEvents {
   return @[@"bugsnag::sync"];
 }
@@ -21,12 +44,43 @@ RCT_EXPORT_MODULE();
 - (void)startObserving {
     __weak __typeof__(self) weakSelf = self;
     self.observerBlock = ^(BugsnagStateEvent * _Nonnull event) {
-        if (weakSelf) {
-            NSDictionary *data = [weakSelf serializeStateChangeData:event];
-            [weakSelf sendEventWithName:@"bugsnag::sync" body:data];
+        if (BSGChangesFromJSDepth && BSGSuppressesChangesFromJS) {
+            return;
         }
+        [weakSelf enqueueStateChange:event];
     };
-    [[Bugsnag client] addObserverWithBlock:self.observerBlock];
+    // Not coalesced by the client, so that changes from JS can be recognised; they are coalesced here instead.
+    [[Bugsnag client] addObserverWithBlock:self.observerBlock coalescingMetadataChanges:NO];
+}
+
+/// Each change is serialized and sent over the bridge, so only the latest of each type is sent, once the main
+/// queue next runs.
+- (void)enqueueStateChange:(BugsnagStateEvent *)event {
+    @synchronized (self) {
+        BOOL flushScheduled = self.pendingEvents.count > 0;
+        if (!self.pendingEvents) {
+            self.pendingEvents = [NSMutableDictionary dictionary];
+        }
+        self.pendingEvents[event.type] = event;
+        if (flushScheduled) {
+            return;
+        }
+    }
+    __weak __typeof__(self) weakSelf = self;
+    dispatch_async(dispatch_get_main_queue(), ^{
+        [weakSelf flushStateChanges];
+    });
+}
+
+- (void)flushStateChanges {
+    NSArray<BugsnagStateEvent *> *events;
+    @synchronized (self) {
+        events = self.pendingEvents.allValues;
+        [self.pendingEvents removeAllObjects];
+    }
+    for (BugsnagStateEvent *event in events) {
+        [self sendEventWithName:@"bugsnag::sync" body:[self serializeStateChangeData:event]];
+    }
 }
 
 - (void)stopObserving {
@@ -0,0 +1,21 @@
+#import <Foundation/Foundation.h>
+
+@class BugsnagReactNative;
+@class RCTBridge;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Installs `global.__bugsnagNativeClient` into the bridge's JavaScript runtime.
+ * Its functions call straight into the module instead of queueing a message on
+ * the bridge, so breadcrumbs and metadata changes don't wait behind other batched
+ * native calls or pay for argument conversion by the bridge.
+ *
+ * Must be called on the JavaScript thread.
+ *
+ * @returns NO if the app was built without JSI or the runtime isn't reachable,
+ *          e.g. when running in the remote debugger.
+ */
+FOUNDATION_EXTERN BOOL BSGInstallJSIBindings(BugsnagReactNative *module, RCTBridge *bridge);
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,183 @@
+#import "BugsnagReactNativeJSI.h"
+
+#import "BugsnagReactNative.h"
+#import "BugsnagEventDeserializer.h"
+
+#if __has_include(<jsi/jsi.h>) && __has_include(<React/RCTBridge+Private.h>)
+
+#import <React/RCTBridge+Private.h>
+#import <jsi/jsi.h>
+
+using namespace facebook;
+
+/// Payloads deeper than this are treated as cyclic and truncated.
+static const int BSGJSIMaxDepth = 64;
+
+/// Returns nil if the string is not valid UTF-8, as when a JS string contains a lone surrogate.
+static NSString * BSGStringFromUTF8(const std::string &utf8) {
+    return [[NSString alloc] initWithBytes:utf8.data() length:utf8.size() encoding:NSUTF8StringEncoding];
+}
+
+/**
+ * Converts a JavaScript value in the same way as the bridge does: null values
+ * inside objects and arrays become NSNull, undefined values and functions are
+ * dropped.
+ */
+static id BSGConvertJSIValue(jsi::Runtime &runtime, const jsi::Value &value, int depth) {
+    if (value.isUndefined()) {
+        return nil;
+    }
+    if (value.isNull()) {
+        return [NSNull null];
+    }
+    if (value.isBool()) {
+        return @(value.getBool());
+    }
+    if (value.isNumber()) {
+        return @(value.getNumber());
+    }
+    if (value.isString()) {
+        return BSGStringFromUTF8(value.getString(runtime).utf8(runtime));
+    }
+    if (!value.isObject() || depth >= BSGJSIMaxDepth) {
+        return nil;
+    }
+    jsi::Object object = value.getObject(runtime);
+    if (object.isFunction(runtime)) {
+        return nil;
+    }
+    if (object.isArray(runtime)) {
+        jsi::Array array = object.getArray(runtime);
+        size_t length = array.size(runtime);
+        NSMutableArray *result = [NSMutableArray arrayWithCapacity:length];
+        for (size_t i = 0; i < length; i++) {
+            id element = BSGConvertJSIValue(runtime, array.getValueAtIndex(runtime, i), depth + 1);
+            [result addObject:element ?: [NSNull null]];
+        }
+        return result;
+    }
+    jsi::Array names = object.getPropertyNames(runtime);
+    size_t length = names.size(runtime);
+    NSMutableDictionary *result = [NSMutableDictionary dictionaryWithCapacity:length];
+    for (size_t i = 0; i < length; i++) {
+        jsi::String name = names.getValueAtIndex(runtime, i).getString(runtime);
+        // A key that can't be converted is dropped along with its value, as a nil key can't be stored.
+        NSString *key = BSGStringFromUTF8(name.utf8(runtime));
+        if (!key) {
+            continue;
+        }
+        id element = BSGConvertJSIValue(runtime, object.getProperty(runtime, name), depth + 1);
+        if (element) {
+            result[key] = element;
+        }
+    }
+    return result;
+}
+
+/// Converts argument `index`, mapping a missing, null or mistyped argument to nil.
+static id BSGJSIArgumentOfClass(jsi::Runtime &runtime, const jsi::Value *arguments, size_t count, size_t index, Class cls) {
+    if (index >= count) {
+        return nil;
+    }
+    id value = BSGConvertJSIValue(runtime, arguments[index], 0);
+    return [value isKindOfClass:cls] ? value : nil;
+}
+
+typedef void (^BSGJSIMethod)(jsi::Runtime &runtime, const jsi::Value *arguments, size_t count);
+
+static void BSGJSIInstallMethod(jsi::Runtime &runtime, jsi::Object &target, const char *name, unsigned int paramCount, BSGJSIMethod method) {
+    target.setProperty(runtime, name, jsi::Function::createFromHostFunction(
+        runtime, jsi::PropNameID::forAscii(runtime, name), paramCount,
+        [method](jsi::Runtime &rt, const jsi::Value &, const jsi::Value *arguments, size_t count) -> jsi::Value {
+            @autoreleasepool {
+                method(rt, arguments, count);
+            }
+            return jsi::Value::undefined();
+        }));
+}
+
+BOOL BSGInstallJSIBindings(BugsnagReactNative *module, RCTBridge *bridge) {
+    if (![bridge isKindOfClass:[RCTCxxBridge class]]) {
+        return NO;
+    }
+    jsi::Runtime *runtime = (jsi::Runtime *)((RCTCxxBridge *)bridge).runtime;
+    if (!runtime) {
+        return NO;
+    }
+
+    __weak BugsnagReactNative *weakModule = module;
+
+    // Events are built from the payload on a background queue, so that
+    // deserializing and storing them doesn't block the JavaScript thread.
+    dispatch_queue_t dispatchQueue = dispatch_queue_create("com.bugsnag.react-native.dispatch", DISPATCH_QUEUE_SERIAL);
+
+    jsi::Object client(*runtime);
+
+    BSGJSIInstallMethod(*runtime, client, "leaveBreadcrumb", 1, ^(jsi::Runtime &rt, const jsi::Value *arguments, size_t count) {
+        [weakModule leaveBreadcrumb:BSGJSIArgumentOfClass(rt, arguments, count, 0, [NSDictionary class])];
+    });
+
+    BSGJSIInstallMethod(*runtime, client, "leaveBreadcrumbs", 1, ^(jsi::Runtime &rt, const jsi::Value *arguments, size_t count) {
+        [weakModule leaveBreadcrumbs:BSGJSIArgumentOfClass(rt, arguments, count, 0, [NSArray class])];
+    });
+
+    BSGJSIInstallMethod(*runtime, client, "addMetadata", 2, ^(jsi::Runtime &rt, const jsi::Value *arguments, size_t count) {
+        NSString *section = BSGJSIArgumentOfClass(rt, arguments, count, 0, [NSString class]);
+        NSDictionary *data = BSGJSIArgumentOfClass(rt, arguments, count, 1, [NSDictionary class]);
+        if (section) {
+            [weakModule addMetadata:section withData:data];
+        }
+    });
+
+    BSGJSIInstallMethod(*runtime, client, "updateMetadata", 3, ^(jsi::Runtime &rt, const jsi::Value *arguments, size_t count) {
+        NSString *section = BSGJSIArgumentOfClass(rt, arguments, count, 0, [NSString class]);
+        NSDictionary *values = BSGJSIArgumentOfClass(rt, arguments, count, 1, [NSDictionary class]);
+        NSArray *removedKeys = BSGJSIArgumentOfClass(rt, arguments, count, 2, [NSArray class]);
+        if (section) {
+            [weakModule updateMetadata:section withValues:values removedKeys:removedKeys];
+        }
+    });
+
+    BSGJSIInstallMethod(*runtime, client, "clearMetadata", 2, ^(jsi::Runtime &rt, const jsi::Value *arguments, size_t count) {
+        NSString *section = BSGJSIArgumentOfClass(rt, arguments, count, 0, [NSString class]);
+        NSString *key = BSGJSIArgumentOfClass(rt, arguments, count, 1, [NSString class]);
+        if (section) {
+            [weakModule clearMetadata:section withKey:(id)key];
+        }
+    });
+
+    BSGJSIInstallMethod(*runtime, client, "updateContext", 1, ^(jsi::Runtime &rt, const jsi::Value *arguments, size_t count) {
+        [weakModule updateContext:BSGJSIArgumentOfClass(rt, arguments, count, 0, [NSString class])];
+    });
+
+    BSGJSIInstallMethod(*runtime, client, "updateUser", 3, ^(jsi::Runtime &rt, const jsi::Value *arguments, size_t count) {
+        [weakModule updateUser:BSGJSIArgumentOfClass(rt, arguments, count, 0, [NSString class])
+                     withEmail:BSGJSIArgumentOfClass(rt, arguments, count, 1, [NSString class])
+                      withName:BSGJSIArgumentOfClass(rt, arguments, count, 2, [NSString class])];
+    });
+
+    BSGJSIInstallMethod(*runtime, client, "dispatch", 1, ^(jsi::Runtime &rt, const jsi::Value *arguments, size_t count) {
+        // The payload has to be read on the JavaScript thread, but the event
+        // doesn't need to be. The native state is captured here, before any
+        // later breadcrumbs or state changes from JavaScript land.
+        NSDictionary *payload = BSGJSIArgumentOfClass(rt, arguments, count, 0, [NSDictionary class]);
+        if (payload) {
+            BugsnagEventDeserializer *deserializer = [BugsnagEventDeserializer new];
+            [deserializer captureNativeStateForPayload:payload];
+            dispatch_async(dispatchQueue, ^{
+                [weakModule dispatchPayload:payload deserializer:deserializer];
+            });
+        }
+    });
+
+    runtime->global().setProperty(*runtime, "__bugsnagNativeClient", client);
+    return YES;
+}
+
+#else
+
+BOOL BSGInstallJSIBindings(__unused BugsnagReactNative *module, __unused RCTBridge *bridge) {
+    return NO;
+}
+
+#endif
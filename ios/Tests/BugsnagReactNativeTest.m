@@ -8,6 +8,54 @@
 
 #import <XCTest/XCTest.h>
 
+#import "BSG_KSJSONCodec.h"
+
+int bsg_ksjsoncodec_i_appendEscapedString(BSG_KSJSONEncodeContext *const context,
+                                          const char *restrict const string,
+                                          size_t length);
+
+static int BSGTestAppendData(const char *data, size_t length, void *userData) {
+    [(__bridge NSMutableData *)userData appendBytes:data length:length];
+    return BSG_KSJSON_OK;
+}
+
+/// Escapes a string one byte at a time, as the codec did before it scanned 16 bytes at a time.
+static NSData * BSGTestScalarEscape(const char *string, size_t length) {
+    NSMutableData *data = [NSMutableData data];
+    for (size_t i = 0; i < length; i++) {
+        const unsigned char c = (unsigned char)string[i];
+        char escaped[7];
+        switch (c) {
+            case '\\':
+            case '\"':  snprintf(escaped, sizeof(escaped), "\\%c", c); break;
+            case '\b':  snprintf(escaped, sizeof(escaped), "\\b"); break;
+            case '\f':  snprintf(escaped, sizeof(escaped), "\\f"); break;
+            case '\n':  snprintf(escaped, sizeof(escaped), "\\n"); break;
+            case '\r':  snprintf(escaped, sizeof(escaped), "\\r"); break;
+            case '\t':  snprintf(escaped, sizeof(escaped), "\\t"); break;
+            default:
+                if (c < ' ') {
+                    snprintf(escaped, sizeof(escaped), "\\u%04X", c);
+                } else {
+                    escaped[0] = (char)c;
+                    escaped[1] = '\0';
+                }
+        }
+        [data appendBytes:escaped length:strlen(escaped)];
+    }
+    return data;
+}
+
+static NSData * BSGTestCodecEscape(const char *string, size_t length) {
+    NSMutableData *data = [NSMutableData data];
+    BSG_KSJSONEncodeContext context;
+    bsg_ksjsonbeginEncode(&context, false, BSGTestAppendData, (__bridge void *)data);
+    if (bsg_ksjsoncodec_i_appendEscapedString(&context, string, length) != BSG_KSJSON_OK) {
+        return nil;
+    }
+    return data;
+}
+
 @interface BugsnagReactNativeTest : XCTestCase
 
 @end
@@ -18,4 +66,44 @@
     // TODO add tests
 }
 
+- (void)testJSONEscapeMatchesScalarAroundChunkBoundaries {
+    const size_t lengths[] = {0, 1, 15, 16, 17, 31, 32, 33, 47, 48, 49, 64};
+    const unsigned char specials[] = {'\"', '\\', '\0', 0x01, '\b', '\t', '\n', '\f', '\r', 0x1F,
+                                      ' ', 0x7F, 0x80, 0xC3, 0xE2, 0xFF};
+    char string[64];
+    for (size_t l = 0; l < sizeof(lengths) / sizeof(*lengths); l++) {
+        const size_t length = lengths[l];
+        memset(string, 'a', sizeof(string));
+        XCTAssertEqualObjects(BSGTestCodecEscape(string, length), BSGTestScalarEscape(string, length),
+                              @"length %zu", length);
+        for (size_t s = 0; s < sizeof(specials); s++) {
+            for (size_t position = 0; position < length; position++) {
+                memset(string, 'a', sizeof(string));
+                string[position] = (char)specials[s];
+                XCTAssertEqualObjects(BSGTestCodecEscape(string, length), BSGTestScalarEscape(string, length),
+                                      @"length %zu, byte 0x%02X at %zu", length, specials[s], position);
+            }
+        }
+    }
+}
+
+- (void)testJSONEscapeMatchesScalarOnRandomStrings {
+    const unsigned char alphabet[] = {'a', 'Z', '0', ' ', '~', '\"', '\\', '\0', 0x01, '\n', 0x1F, 0x7F,
+                                      0x80, 0xC3, 0xA9, 0xFF};
+    char string[600];
+    srand48(42);
+    for (int iteration = 0; iteration < 2000; iteration++) {
+        const size_t length = (size_t)(lrand48() % (long)sizeof(string));
+        // Mostly clean strings with occasional escapes, so that long clean runs are exercised too.
+        const long escapeOneIn = 1 + lrand48() % 64;
+        for (size_t i = 0; i < length; i++) {
+            string[i] = lrand48() % escapeOneIn
+            ? (char)('a' + lrand48() % 26)
+            : (char)alphabet[lrand48() % (long)sizeof(alphabet)];
+        }
+        XCTAssertEqualObjects(BSGTestCodecEscape(string, length), BSGTestScalarEscape(string, length),
+                              @"iteration %d, length %zu", iteration, length);
+    }
+}
+
 @end
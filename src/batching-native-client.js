@@ -0,0 +1,51 @@
+// Breadcrumbs are left very frequently (console and network breadcrumbs in
+// particular), so rather than crossing the bridge once per breadcrumb they are
+// queued and sent to the native client in batches.
+const DEFAULT_MAX_BATCH_SIZE = 25
+const DEFAULT_FLUSH_INTERVAL = 100
+
+// Wraps NativeClient so that calls to leaveBreadcrumb() are coalesced into calls
+// to leaveBreadcrumbs(), which happen once maxBatchSize breadcrumbs are queued or
+// flushInterval ms after the first of them, whichever comes first.
+//
+// Any other native method flushes the queue before it is called, so the native
+// layer sees breadcrumbs and other calls (such as dispatching an event) in the
+// order JS made them.
+module.exports = (NativeClient, { maxBatchSize = DEFAULT_MAX_BATCH_SIZE, flushInterval = DEFAULT_FLUSH_INTERVAL } = {}) => {
+  if (!NativeClient || typeof NativeClient.leaveBreadcrumbs !== 'function') return NativeClient
+
+  let queue = []
+  let timer = null
+
+  const flush = () => {
+    if (timer !== null) {
+      clearTimeout(timer)
+      timer = null
+    }
+    if (queue.length === 0) return
+    const batch = queue
+    queue = []
+    NativeClient.leaveBreadcrumbs(batch)
+  }
+
+  const leaveBreadcrumb = (breadcrumb) => {
+    queue.push(breadcrumb)
+    if (queue.length >= maxBatchSize) {
+      flush()
+    } else if (timer === null) {
+      timer = setTimeout(flush, flushInterval)
+    }
+  }
+
+  return new Proxy(NativeClient, {
+    get: (target, prop) => {
+      if (prop === 'leaveBreadcrumb') return leaveBreadcrumb
+      const value = target[prop]
+      if (typeof value !== 'function') return value
+      return function () {
+        flush()
+        return value.apply(target, arguments)
+      }
+    }
+  })
+}
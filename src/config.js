@@ -3,7 +3,7 @@ const stringWithLength = require('@bugsnag/core/lib/validators/string-with-lengt
 const rnPackage = require('react-native/package.json')
 const iserror = require('iserror')
 
-const ALLOWED_IN_JS = ['onError', 'onBreadcrumb', 'logger', 'metadata', 'user', 'context', 'codeBundleId', 'plugins']
+const ALLOWED_IN_JS = ['onError', 'onBreadcrumb', 'logger', 'metadata', 'user', 'context', 'codeBundleId', 'nativePayloadEnrichment', 'plugins']
 const allowedErrorTypes = () => ({
   unhandledExceptions: true,
   unhandledRejections: true,
@@ -23,6 +23,26 @@ module.exports.schema = {
     message: 'should be a string',
     validate: val => (val === null || stringWithLength(val))
   },
+  // lets the native layer attach app, device, breadcrumbs and threads to JS errors, rather than
+  // sending them to JS and back, while no onError callbacks are registered that could read them
+  nativePayloadEnrichment: {
+    defaultValue: () => false,
+    message: 'should be true|false',
+    validate: val => val === true || val === false
+  },
+  // sent to the native layer with the notifier's details: JS applies its own state changes
+  // before sending them, so the native layer need not send them back
+  suppressSyncEchoes: {
+    defaultValue: () => true,
+    message: 'should be true|false',
+    validate: val => val === true || val === false
+  },
+  // set by the native layer when it records network requests itself
+  nativeNetworkBreadcrumbs: {
+    defaultValue: () => false,
+    message: 'should be true|false',
+    validate: val => val === true || val === false
+  },
   enabledErrorTypes: {
     ...schema.enabledErrorTypes,
     defaultValue: () => allowedErrorTypes(),
@@ -66,6 +86,21 @@ const getPrefixedConsole = () => {
 const getEngine = () => global.HermesInternal ? 'hermes' : 'jsc'
 const getReactNativeVersion = () => rnPackage.version
 
+// Native clients that serialize their configuration ahead of time export it as
+// a constant, which can be read without a blocking call across the bridge
+const getNotifierInfo = (notifierVersion, engine, reactNativeVersion) => ({
+  notifierVersion,
+  engine,
+  reactNativeVersion,
+  suppressSyncEchoes: module.exports.schema.suppressSyncEchoes.defaultValue()
+})
+
+const getPrecomputedConfig = (NativeClient) => {
+  if (typeof NativeClient.configureNotifier !== 'function') return null
+  const constants = typeof NativeClient.getConstants === 'function' ? NativeClient.getConstants() : NativeClient
+  return (constants && constants.configuration) || null
+}
+
 module.exports.load = (
   NativeClient,
   notifierVersion,
@@ -73,7 +108,13 @@ module.exports.load = (
   reactNativeVersion = getReactNativeVersion(),
   warn = console.warn
 ) => {
-  const nativeOpts = NativeClient.configure({ notifierVersion, engine, reactNativeVersion })
+  const notifierInfo = getNotifierInfo(notifierVersion, engine, reactNativeVersion)
+  const precomputedOpts = getPrecomputedConfig(NativeClient)
+  if (precomputedOpts) {
+    NativeClient.configureNotifier(notifierInfo)
+    return freeze(precomputedOpts, warn)
+  }
+  const nativeOpts = NativeClient.configure(notifierInfo)
   return freeze(nativeOpts, warn)
 }
 
@@ -84,7 +125,7 @@ module.exports.loadAsync = async (
   reactNativeVersion = getReactNativeVersion(),
   warn = console.warn
 ) => {
-  const nativeOpts = await NativeClient.configureAsync({ notifierVersion, engine, reactNativeVersion })
+  const nativeOpts = await NativeClient.configureAsync(getNotifierInfo(notifierVersion, engine, reactNativeVersion))
   return freeze(nativeOpts, warn)
 }
 
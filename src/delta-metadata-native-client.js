@@ -0,0 +1,67 @@
+// addMetadata() is typically called repeatedly with the same section and mostly
+// unchanged values, and every call serializes the whole section across the bridge
+// and has the native layer sanitize and replace all of it. Instead, only the keys
+// whose values have changed since they were last sent are passed to the native
+// client's updateMetadata(), which applies them to the section in place.
+const stringify = (value) => {
+  try {
+    return JSON.stringify(value)
+  } catch (e) {
+    return undefined
+  }
+}
+
+// Wraps NativeClient so that addMetadata(section, values) sends a delta relative to
+// the values that were last sent for that section. Null values remove their keys, as
+// they do natively. The shadow copy only tracks what JS has sent, so a key that is
+// also written by native code should be cleared from JS before being set again.
+module.exports = (NativeClient) => {
+  if (!NativeClient || typeof NativeClient.updateMetadata !== 'function') return NativeClient
+
+  const sent = {}
+
+  const addMetadata = (section, values) => {
+    if (!values || typeof values !== 'object') return NativeClient.addMetadata(section, values)
+
+    const previous = sent[section] || (sent[section] = {})
+    const changed = {}
+    const removedKeys = []
+    let hasChanges = false
+
+    Object.keys(values).forEach(key => {
+      const value = values[key]
+      if (value === undefined) return
+      if (value === null) {
+        if (key in previous) {
+          delete previous[key]
+          removedKeys.push(key)
+        }
+        return
+      }
+      const serialized = stringify(value)
+      if (serialized !== undefined && previous[key] === serialized) return
+      // values that can't be compared are always sent and never considered unchanged
+      if (serialized === undefined) delete previous[key]
+      else previous[key] = serialized
+      changed[key] = value
+      hasChanges = true
+    })
+
+    if (!hasChanges && removedKeys.length === 0) return
+    NativeClient.updateMetadata(section, changed, removedKeys)
+  }
+
+  const clearMetadata = (section, key) => {
+    if (key === undefined || key === null) delete sent[section]
+    else if (sent[section]) delete sent[section][key]
+    return NativeClient.clearMetadata(section, key)
+  }
+
+  return new Proxy(NativeClient, {
+    get: (target, prop) => {
+      if (prop === 'addMetadata') return addMetadata
+      if (prop === 'clearMetadata') return clearMetadata
+      return target[prop]
+    }
+  })
+}
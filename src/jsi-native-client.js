@@ -0,0 +1,55 @@
+// Every call through the bridge is queued, batched and has its arguments
+// converted before native code sees it. When the native module can install JSI
+// bindings, the frequent calls go straight to native code instead.
+
+const JSI_METHODS = [
+  'leaveBreadcrumb',
+  'leaveBreadcrumbs',
+  'addMetadata',
+  'updateMetadata',
+  'clearMetadata',
+  'updateContext',
+  'updateUser'
+]
+
+// Wraps NativeClient so that the methods above, and dispatch(), use the JSI
+// bindings. Returns NativeClient unchanged if they can't be installed, e.g. on
+// Android or when running in the remote debugger.
+module.exports = (NativeClient, runtimeGlobal = global) => {
+  if (!NativeClient || typeof NativeClient.installJSI !== 'function') return NativeClient
+
+  // synchronous native methods don't work in the remote debugger
+  if (!runtimeGlobal.nativeCallSyncHook) return NativeClient
+
+  let installed = false
+  try {
+    installed = NativeClient.installJSI()
+  } catch (e) {}
+
+  const jsi = installed && runtimeGlobal.__bugsnagNativeClient
+  if (!jsi) return NativeClient
+
+  const overrides = {}
+  JSI_METHODS.forEach(method => {
+    if (typeof jsi[method] === 'function') overrides[method] = (...args) => jsi[method](...args)
+  })
+
+  // callers expect dispatch() to return a promise, as it does over the bridge
+  if (typeof jsi.dispatch === 'function') {
+    overrides.dispatch = (payload) => {
+      try {
+        jsi.dispatch(payload)
+        return Promise.resolve({})
+      } catch (e) {
+        return Promise.reject(e)
+      }
+    }
+  }
+
+  return new Proxy(NativeClient, {
+    get: (target, prop) => {
+      if (Object.prototype.hasOwnProperty.call(overrides, prop)) return overrides[prop]
+      return target[prop]
+    }
+  })
+}
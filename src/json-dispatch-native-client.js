@@ -0,0 +1,39 @@
+// Event payloads are large, deeply nested objects, and the bridge converts every
+// value in them to a native object before the native client reads the event out
+// of that again. When the native client supports it, the payload is encoded in JS
+// and crosses the bridge as a single string, which native decodes in one pass.
+// Batches of breadcrumbs and state changes are sent in the same way.
+const JSON_METHODS = {
+  dispatch: 'dispatchJSON',
+  leaveBreadcrumbs: 'leaveBreadcrumbsJSON',
+  applyStateChanges: 'applyStateChangesJSON'
+}
+
+// Wraps NativeClient so that dispatch(payload) calls dispatchJSON(json) instead,
+// and likewise for the other methods above. Arguments that can't be encoded, e.g.
+// because they contain a cycle, are passed to the original method unchanged.
+module.exports = (NativeClient) => {
+  if (!NativeClient) return NativeClient
+
+  const overrides = {}
+  Object.keys(JSON_METHODS).forEach(method => {
+    const jsonMethod = JSON_METHODS[method]
+    if (typeof NativeClient[jsonMethod] !== 'function') return
+    overrides[method] = (arg) => {
+      let json
+      try {
+        json = JSON.stringify(arg)
+      } catch (e) {}
+      if (typeof json !== 'string') return NativeClient[method](arg)
+      return NativeClient[jsonMethod](json)
+    }
+  })
+  if (Object.keys(overrides).length === 0) return NativeClient
+
+  return new Proxy(NativeClient, {
+    get: (target, prop) => {
+      if (Object.prototype.hasOwnProperty.call(overrides, prop)) return overrides[prop]
+      return target[prop]
+    }
+  })
+}
@@ -0,0 +1,41 @@
+// For every JS error, getPayloadInfo() has the native client collect its app,
+// device, breadcrumbs and threads and send them across the bridge, only for JS to
+// send them straight back inside the dispatched event. When the native client
+// can attach those itself, neither crossing is needed.
+
+// Wraps NativeClient so that, once enabled with enrichPayloadsWhen(), getPayloadInfo()
+// resolves with empty values without calling native code, and dispatch() marks the
+// payload for the native client to fill in. Anything JS callbacks add to the event is
+// kept alongside the native values, and takes precedence over them.
+//
+// The condition is checked for each call, so that the round trip is still made
+// whenever onError callbacks that could read the native values are registered.
+module.exports = (NativeClient) => {
+  if (!NativeClient || typeof NativeClient.dispatch !== 'function') return NativeClient
+
+  const constants = typeof NativeClient.getConstants === 'function' ? NativeClient.getConstants() : NativeClient
+  if (!constants || constants.enrichesPayloads !== true) return NativeClient
+
+  let shouldEnrich = () => false
+  const enrichPayloadsWhen = (condition) => { shouldEnrich = condition }
+
+  const getPayloadInfo = (...args) => shouldEnrich()
+    ? Promise.resolve({
+        app: {},
+        device: {},
+        breadcrumbs: [],
+        threads: []
+      })
+    : NativeClient.getPayloadInfo(...args)
+
+  const dispatch = (payload) => NativeClient.dispatch(shouldEnrich() ? { ...payload, nativeEnrichment: true } : payload)
+
+  return new Proxy(NativeClient, {
+    get: (target, prop) => {
+      if (prop === 'enrichPayloadsWhen') return enrichPayloadsWhen
+      if (prop === 'getPayloadInfo') return getPayloadInfo
+      if (prop === 'dispatch') return dispatch
+      return target[prop]
+    }
+  })
+}
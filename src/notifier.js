@@ -1,5 +1,22 @@
 const NativeModules = require('react-native').NativeModules
-const NativeClient = NativeModules.BugsnagReactNative
+const InteractionManager = require('react-native').InteractionManager
+const createBatchingNativeClient = require('./batching-native-client')
+const createDeltaMetadataNativeClient = require('./delta-metadata-native-client')
+const createJsonDispatchNativeClient = require('./json-dispatch-native-client')
+const createJsiNativeClient = require('./jsi-native-client')
+const createNativeEnrichmentNativeClient = require('./native-enrichment-native-client')
+const createStateBatchingNativeClient = require('./state-batching-native-client')
+const createTimingNativeClient = require('./timing-native-client')
+
+// Set by benchmark apps before Bugsnag is loaded, to time both the calls the client makes ("client")
+// and those made through the bridge module rather than JSI ("bridge")
+const nativeTimings = typeof global.__bugsnagNativeTimings === 'object' ? global.__bugsnagNativeTimings : null
+const timed = (layer, client) => nativeTimings
+  ? createTimingNativeClient(client, nativeTimings[layer] || (nativeTimings[layer] = {}))
+  : client
+
+// State changes are batched below the JSI client, so only when they would otherwise cross the bridge
+const NativeClient = timed('client', createNativeEnrichmentNativeClient(createBatchingNativeClient(createDeltaMetadataNativeClient(createJsiNativeClient(createStateBatchingNativeClient(createJsonDispatchNativeClient(timed('bridge', NativeModules.BugsnagReactNative))))))))
 
 const REMOTE_DEBUGGING_WARNING = `Bugsnag cannot initialize synchronously when running in the remote debugger.
 
@@ -33,18 +50,37 @@ const BugsnagPluginReact = require('@bugsnag/plugin-react')
 
 const { schema, load, loadAsync } = require('./config')
 
+// requests are recorded natively, off the JS thread, when the native collector is enabled
+const networkBreadcrumbsPlugin = require('@bugsnag/plugin-network-breadcrumbs')()
+
+// installed with the client, so that errors and state changes are captured from the start
+// (the react plugin too, since apps create their error boundary as soon as Bugsnag starts,
+// and the hermes plugin, which corrects the stacktraces of errors thrown during startup)
 const internalPlugins = [
   require('@bugsnag/plugin-react-native-session')(NativeClient),
   require('@bugsnag/plugin-react-native-event-sync')(NativeClient),
   require('@bugsnag/plugin-react-native-client-sync')(NativeClient),
   require('@bugsnag/plugin-react-native-global-error-handler')(),
   require('@bugsnag/plugin-react-native-unhandled-rejection'),
-  require('@bugsnag/plugin-console-breadcrumbs'),
-  require('@bugsnag/plugin-network-breadcrumbs')(),
   require('@bugsnag/plugin-react-native-hermes')(),
   new BugsnagPluginReact(React)
 ]
 
+// only add breadcrumbs, so are installed once the app's startup interactions have finished
+const deferredPlugins = [
+  require('@bugsnag/plugin-console-breadcrumbs'),
+  networkBreadcrumbsPlugin
+]
+
+const loadDeferredPlugins = (client, plugins) => {
+  const load = () => plugins.forEach(plugin => client._loadPlugin(plugin))
+  if (InteractionManager && typeof InteractionManager.runAfterInteractions === 'function') {
+    InteractionManager.runAfterInteractions(load)
+  } else {
+    load()
+  }
+}
+
 const CLIENT_METHODS = Object.getOwnPropertyNames(Client.prototype)
 
 const createClientAsync = async (jsOpts) => {
@@ -63,13 +99,27 @@ const _createClient = (opts, jsOpts) => {
     Object.keys(jsOpts).forEach(k => { opts[k] = jsOpts[k] })
   }
 
-  const bugsnag = new Client(opts, schema, internalPlugins, { name, version, url })
+  const plugins = opts.nativeNetworkBreadcrumbs
+    ? deferredPlugins.filter(p => p !== networkBreadcrumbsPlugin)
+    : deferredPlugins
+
+  // the client validates the options of the plugins it will load later too
+  const pluginSchema = plugins.reduce((accum, p) => p.configSchema ? { ...accum, ...p.configSchema } : accum, schema)
+
+  const bugsnag = new Client(opts, pluginSchema, internalPlugins, { name, version, url })
 
   // if we let JS keep error breadcrumbs, it results in an error containing itself as a breadcrumb
   bugsnag._config.enabledBreadcrumbTypes = bugsnag._config.enabledBreadcrumbTypes.filter(t => t !== 'error')
 
   bugsnag._setDelivery(client => delivery(client, NativeClient))
 
+  if (bugsnag._config.nativePayloadEnrichment && typeof NativeClient.enrichPayloadsWhen === 'function') {
+    // callbacks added by the client's own plugins don't read the values the native layer attaches
+    const configuredCallbacks = [].concat(bugsnag._config.onError)
+    const internalCallbacks = bugsnag._cbs.e.filter(cb => !configuredCallbacks.includes(cb))
+    NativeClient.enrichPayloadsWhen(() => bugsnag._cbs.e.every(cb => internalCallbacks.includes(cb)))
+  }
+
   if (opts.user && opts.user !== opts._originalValues.user) {
     bugsnag.setUser(opts.user.id, opts.user.email, opts.user.name)
   }
@@ -88,6 +138,8 @@ const _createClient = (opts, jsOpts) => {
 
   if (bugsnag._config.autoTrackSessions) bugsnag.resumeSession()
 
+  loadDeferredPlugins(bugsnag, plugins)
+
   bugsnag._logger.debug('Loaded!')
 
   return bugsnag
@@ -119,7 +171,7 @@ const Bugsnag = {
       autoTrackSessions: false,
       autoDetectErrors: false,
       enabledBreadcrumbTypes: []
-    }, stubSchema, internalPlugins, { name, version, url })
+    }, stubSchema, internalPlugins.concat(deferredPlugins), { name, version, url })
 
     CLIENT_METHODS.forEach((m) => {
       if (/^_/.test(m)) return
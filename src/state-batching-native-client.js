@@ -0,0 +1,65 @@
+// Context, user and metadata are often changed several times in quick
+// succession, e.g. when a screen is entered, and each change is a separate
+// bridge crossing. Instead they are queued and applied by the native client's
+// applyStateChanges() in one call.
+const DEFAULT_MAX_BATCH_SIZE = 50
+const DEFAULT_FLUSH_INTERVAL = 10
+
+// Only the latest of these is kept, as each replaces the previous value entirely.
+const REPLACING_TYPES = ['context', 'user']
+
+// Wraps NativeClient so that the state methods below are queued as changes,
+// which are sent once maxBatchSize are queued or flushInterval ms after the
+// first of them, whichever comes first.
+//
+// Any other native method flushes the queue before it is called, so the native
+// layer sees state changes and other calls in the order JS made them.
+module.exports = (NativeClient, { maxBatchSize = DEFAULT_MAX_BATCH_SIZE, flushInterval = DEFAULT_FLUSH_INTERVAL } = {}) => {
+  if (!NativeClient || typeof NativeClient.applyStateChanges !== 'function') return NativeClient
+
+  let queue = []
+  let timer = null
+
+  const flush = () => {
+    if (timer !== null) {
+      clearTimeout(timer)
+      timer = null
+    }
+    if (queue.length === 0) return
+    const batch = queue
+    queue = []
+    NativeClient.applyStateChanges(batch)
+  }
+
+  const enqueue = (change) => {
+    if (REPLACING_TYPES.includes(change.type)) {
+      queue = queue.filter(queued => queued.type !== change.type)
+    }
+    queue.push(change)
+    if (queue.length >= maxBatchSize) {
+      flush()
+    } else if (timer === null) {
+      timer = setTimeout(flush, flushInterval)
+    }
+  }
+
+  const overrides = {
+    updateContext: (context) => enqueue({ type: 'context', context }),
+    updateUser: (id, email, name) => enqueue({ type: 'user', id, email, name }),
+    addMetadata: (section, data) => enqueue({ type: 'addMetadata', section, data }),
+    updateMetadata: (section, values, removedKeys) => enqueue({ type: 'updateMetadata', section, values, removedKeys }),
+    clearMetadata: (section, key) => enqueue({ type: 'clearMetadata', section, key })
+  }
+
+  return new Proxy(NativeClient, {
+    get: (target, prop) => {
+      if (Object.prototype.hasOwnProperty.call(overrides, prop)) return overrides[prop]
+      const value = target[prop]
+      if (typeof value !== 'function') return value
+      return function () {
+        flush()
+        return value.apply(target, arguments)
+      }
+    }
+  })
+}
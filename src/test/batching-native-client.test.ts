@@ -0,0 +1,62 @@
+import createBatchingNativeClient from '../batching-native-client'
+
+describe('react-native: batching native client', () => {
+  beforeEach(() => {
+    jest.useFakeTimers()
+  })
+
+  afterEach(() => {
+    jest.useRealTimers()
+  })
+
+  const createMockNativeClient = () => ({
+    leaveBreadcrumb: jest.fn(),
+    leaveBreadcrumbs: jest.fn(),
+    dispatch: jest.fn(() => 'dispatched')
+  })
+
+  it('sends queued breadcrumbs after the flush interval', () => {
+    const NativeClient = createMockNativeClient()
+    const client = createBatchingNativeClient(NativeClient, { flushInterval: 50 })
+    client.leaveBreadcrumb({ message: 'a' })
+    client.leaveBreadcrumb({ message: 'b' })
+    expect(NativeClient.leaveBreadcrumbs).not.toHaveBeenCalled()
+
+    jest.advanceTimersByTime(50)
+    expect(NativeClient.leaveBreadcrumbs).toHaveBeenCalledTimes(1)
+    expect(NativeClient.leaveBreadcrumbs).toHaveBeenCalledWith([{ message: 'a' }, { message: 'b' }])
+    expect(NativeClient.leaveBreadcrumb).not.toHaveBeenCalled()
+  })
+
+  it('sends a batch as soon as it is full', () => {
+    const NativeClient = createMockNativeClient()
+    const client = createBatchingNativeClient(NativeClient, { maxBatchSize: 2 })
+    client.leaveBreadcrumb({ message: 'a' })
+    client.leaveBreadcrumb({ message: 'b' })
+    client.leaveBreadcrumb({ message: 'c' })
+    expect(NativeClient.leaveBreadcrumbs).toHaveBeenCalledTimes(1)
+    expect(NativeClient.leaveBreadcrumbs).toHaveBeenCalledWith([{ message: 'a' }, { message: 'b' }])
+
+    jest.runAllTimers()
+    expect(NativeClient.leaveBreadcrumbs).toHaveBeenCalledTimes(2)
+    expect(NativeClient.leaveBreadcrumbs).toHaveBeenLastCalledWith([{ message: 'c' }])
+  })
+
+  it('flushes queued breadcrumbs before calling any other native method', () => {
+    const NativeClient = createMockNativeClient()
+    const client = createBatchingNativeClient(NativeClient)
+    client.leaveBreadcrumb({ message: 'a' })
+    expect(client.dispatch({})).toBe('dispatched')
+    expect(NativeClient.leaveBreadcrumbs).toHaveBeenCalledWith([{ message: 'a' }])
+    expect(NativeClient.leaveBreadcrumbs.mock.invocationCallOrder[0])
+      .toBeLessThan(NativeClient.dispatch.mock.invocationCallOrder[0])
+
+    jest.runAllTimers()
+    expect(NativeClient.leaveBreadcrumbs).toHaveBeenCalledTimes(1)
+  })
+
+  it('returns the native client unchanged if it does not support batches', () => {
+    const NativeClient = { leaveBreadcrumb: jest.fn() }
+    expect(createBatchingNativeClient(NativeClient)).toBe(NativeClient)
+  })
+})
@@ -1,4 +1,4 @@
-import { load, schema } from '../config'
+import { load, loadAsync, schema } from '../config'
 
 describe('react-native config: load()', () => {
   it('should load config from the provided NativeClient', () => {
@@ -12,6 +12,39 @@ describe('react-native config: load()', () => {
     expect(config._originalValues).toEqual({ apiKey: '123' })
   })
 
+  it('should use the precomputed config from the NativeClient’s constants', () => {
+    const mockNativeClient = {
+      configure: jest.fn(() => ({ apiKey: '456' })),
+      configureNotifier: jest.fn(),
+      getConstants: () => ({ configuration: { apiKey: '123' } })
+    }
+    const config = load(mockNativeClient, '1.1.1', 'hermes', '2.2.2')
+    expect((config as any).apiKey).toBe('123')
+    expect(mockNativeClient.configure).not.toHaveBeenCalled()
+    expect(mockNativeClient.configureNotifier).toHaveBeenCalledWith({ notifierVersion: '1.1.1', engine: 'hermes', reactNativeVersion: '2.2.2', suppressSyncEchoes: true })
+  })
+
+  it('should fall back to configure() when there is no precomputed config', () => {
+    const mockNativeClient = {
+      configure: jest.fn(() => ({ apiKey: '123' })),
+      configureNotifier: jest.fn(),
+      getConstants: () => ({})
+    }
+    const config = load(mockNativeClient)
+    expect((config as any).apiKey).toBe('123')
+    expect(mockNativeClient.configure).toHaveBeenCalledWith(expect.objectContaining({ suppressSyncEchoes: true }))
+    expect(mockNativeClient.configureNotifier).not.toHaveBeenCalled()
+  })
+
+  it('should ask configureAsync() not to echo state changes back', async () => {
+    const mockNativeClient = {
+      configureAsync: jest.fn(() => Promise.resolve({ apiKey: '123' }))
+    }
+    const config = await loadAsync(mockNativeClient)
+    expect((config as any).apiKey).toBe('123')
+    expect(mockNativeClient.configureAsync).toHaveBeenCalledWith(expect.objectContaining({ suppressSyncEchoes: true }))
+  })
+
   it('should throw if the provided NativeClient didn’t provide an object', () => {
     const mockNativeClient = {
       configure: () => {}
@@ -56,4 +89,25 @@ describe('react-native config: load()', () => {
       ooms: true
     })).toBe(false)
   })
+
+  it('only accepts a boolean for nativeNetworkBreadcrumbs', () => {
+    expect(schema.nativeNetworkBreadcrumbs.defaultValue()).toBe(false)
+    expect(schema.nativeNetworkBreadcrumbs.validate(true)).toBe(true)
+    expect(schema.nativeNetworkBreadcrumbs.validate('true')).toBe(false)
+
+    const config: any = load({ configure: () => ({ apiKey: '123', nativeNetworkBreadcrumbs: true }) })
+    expect(config.nativeNetworkBreadcrumbs).toBe(true)
+  })
+
+  it('allows nativePayloadEnrichment to be set in JS', () => {
+    expect(schema.nativePayloadEnrichment.defaultValue()).toBe(false)
+    expect(schema.nativePayloadEnrichment.validate('true')).toBe(false)
+
+    const warn = jest.spyOn(console, 'warn').mockImplementation(() => {})
+    const config: any = load({ configure: () => ({ apiKey: '123' }) })
+    config.nativePayloadEnrichment = true
+    expect(config.nativePayloadEnrichment).toBe(true)
+    expect(warn).not.toHaveBeenCalled()
+    warn.mockRestore()
+  })
 })
@@ -0,0 +1,77 @@
+import createDeltaMetadataNativeClient from '../delta-metadata-native-client'
+
+describe('react-native: delta metadata native client', () => {
+  const createMockNativeClient = () => ({
+    addMetadata: jest.fn(),
+    updateMetadata: jest.fn(),
+    clearMetadata: jest.fn(),
+    dispatch: jest.fn(() => 'dispatched')
+  })
+
+  it('only sends values that have changed', () => {
+    const NativeClient = createMockNativeClient()
+    const client = createDeltaMetadataNativeClient(NativeClient)
+    client.addMetadata('app', { a: 1, b: { c: 'd' } })
+    expect(NativeClient.updateMetadata).toHaveBeenCalledWith('app', { a: 1, b: { c: 'd' } }, [])
+
+    client.addMetadata('app', { a: 2, b: { c: 'd' } })
+    expect(NativeClient.updateMetadata).toHaveBeenCalledTimes(2)
+    expect(NativeClient.updateMetadata).toHaveBeenLastCalledWith('app', { a: 2 }, [])
+    expect(NativeClient.addMetadata).not.toHaveBeenCalled()
+  })
+
+  it('does not cross the bridge when nothing has changed', () => {
+    const NativeClient = createMockNativeClient()
+    const client = createDeltaMetadataNativeClient(NativeClient)
+    client.addMetadata('app', { a: 1 })
+    client.addMetadata('app', { a: 1 })
+    client.addMetadata('app', { b: undefined })
+    expect(NativeClient.updateMetadata).toHaveBeenCalledTimes(1)
+  })
+
+  it('sends null values as removed keys', () => {
+    const NativeClient = createMockNativeClient()
+    const client = createDeltaMetadataNativeClient(NativeClient)
+    client.addMetadata('app', { a: 1, b: 2 })
+    client.addMetadata('app', { a: null, c: null })
+    expect(NativeClient.updateMetadata).toHaveBeenLastCalledWith('app', {}, ['a'])
+
+    client.addMetadata('app', { a: 1 })
+    expect(NativeClient.updateMetadata).toHaveBeenLastCalledWith('app', { a: 1 }, [])
+  })
+
+  it('resends values after they are cleared', () => {
+    const NativeClient = createMockNativeClient()
+    const client = createDeltaMetadataNativeClient(NativeClient)
+    client.addMetadata('app', { a: 1, b: 2 })
+    client.clearMetadata('app', 'a')
+    expect(NativeClient.clearMetadata).toHaveBeenCalledWith('app', 'a')
+    client.addMetadata('app', { a: 1, b: 2 })
+    expect(NativeClient.updateMetadata).toHaveBeenLastCalledWith('app', { a: 1 }, [])
+
+    client.clearMetadata('app')
+    client.addMetadata('app', { a: 1, b: 2 })
+    expect(NativeClient.updateMetadata).toHaveBeenLastCalledWith('app', { a: 1, b: 2 }, [])
+  })
+
+  it('always sends values that cannot be serialized', () => {
+    const NativeClient = createMockNativeClient()
+    const client = createDeltaMetadataNativeClient(NativeClient)
+    const circular: any = {}
+    circular.self = circular
+    client.addMetadata('app', { a: circular })
+    client.addMetadata('app', { a: circular })
+    expect(NativeClient.updateMetadata).toHaveBeenCalledTimes(2)
+  })
+
+  it('passes other calls through', () => {
+    const NativeClient = createMockNativeClient()
+    const client = createDeltaMetadataNativeClient(NativeClient)
+    expect(client.dispatch({})).toBe('dispatched')
+  })
+
+  it('returns the native client unchanged when it does not support deltas', () => {
+    const NativeClient = { addMetadata: jest.fn() }
+    expect(createDeltaMetadataNativeClient(NativeClient)).toBe(NativeClient)
+  })
+})
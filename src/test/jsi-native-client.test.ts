@@ -0,0 +1,77 @@
+import createJsiNativeClient from '../jsi-native-client'
+
+describe('react-native: jsi native client', () => {
+  const createMockJsi = () => ({
+    leaveBreadcrumb: jest.fn(),
+    leaveBreadcrumbs: jest.fn(),
+    addMetadata: jest.fn(),
+    updateMetadata: jest.fn(),
+    clearMetadata: jest.fn(),
+    updateContext: jest.fn(),
+    updateUser: jest.fn(),
+    dispatch: jest.fn()
+  })
+
+  const createMockNativeClient = (runtimeGlobal: any, jsi: any) => ({
+    installJSI: jest.fn(() => {
+      runtimeGlobal.__bugsnagNativeClient = jsi
+      return true
+    }),
+    leaveBreadcrumb: jest.fn(),
+    dispatch: jest.fn(() => Promise.resolve({})),
+    getPayloadInfo: jest.fn(() => 'payload info')
+  })
+
+  it('calls the JSI bindings once installed', () => {
+    const runtimeGlobal: any = { nativeCallSyncHook: () => {} }
+    const jsi = createMockJsi()
+    const NativeClient = createMockNativeClient(runtimeGlobal, jsi)
+    const client = createJsiNativeClient(NativeClient, runtimeGlobal)
+
+    client.leaveBreadcrumb({ message: 'a' })
+    client.updateMetadata('s', { a: 1 }, ['b'])
+    client.updateUser('123', 'bug@sn.ag', 'Bug S. Nag')
+
+    expect(NativeClient.installJSI).toHaveBeenCalledTimes(1)
+    expect(jsi.leaveBreadcrumb).toHaveBeenCalledWith({ message: 'a' })
+    expect(jsi.updateMetadata).toHaveBeenCalledWith('s', { a: 1 }, ['b'])
+    expect(jsi.updateUser).toHaveBeenCalledWith('123', 'bug@sn.ag', 'Bug S. Nag')
+    expect(NativeClient.leaveBreadcrumb).not.toHaveBeenCalled()
+  })
+
+  it('returns a promise from dispatch()', async () => {
+    const runtimeGlobal: any = { nativeCallSyncHook: () => {} }
+    const jsi = createMockJsi()
+    const NativeClient = createMockNativeClient(runtimeGlobal, jsi)
+    const client = createJsiNativeClient(NativeClient, runtimeGlobal)
+
+    const payload = { errors: [] }
+    await expect(client.dispatch(payload)).resolves.toEqual({})
+    expect(jsi.dispatch).toHaveBeenCalledWith(payload)
+    expect(NativeClient.dispatch).not.toHaveBeenCalled()
+
+    jsi.dispatch.mockImplementation(() => { throw new Error('nope') })
+    await expect(client.dispatch(payload)).rejects.toThrow('nope')
+  })
+
+  it('passes other calls through to the bridge', () => {
+    const runtimeGlobal: any = { nativeCallSyncHook: () => {} }
+    const NativeClient = createMockNativeClient(runtimeGlobal, createMockJsi())
+    const client = createJsiNativeClient(NativeClient, runtimeGlobal)
+    expect(client.getPayloadInfo({ unhandled: false })).toBe('payload info')
+  })
+
+  it('returns the native client unchanged when the bindings are unavailable', () => {
+    const remoteDebugger: any = {}
+    const NativeClient = createMockNativeClient(remoteDebugger, createMockJsi())
+    expect(createJsiNativeClient(NativeClient, remoteDebugger)).toBe(NativeClient)
+    expect(NativeClient.installJSI).not.toHaveBeenCalled()
+
+    const runtimeGlobal: any = { nativeCallSyncHook: () => {} }
+    const failing = { installJSI: jest.fn(() => false), dispatch: jest.fn() }
+    expect(createJsiNativeClient(failing, runtimeGlobal)).toBe(failing)
+
+    const android = { dispatch: jest.fn() }
+    expect(createJsiNativeClient(android, runtimeGlobal)).toBe(android)
+  })
+})
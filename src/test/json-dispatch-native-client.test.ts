@@ -0,0 +1,56 @@
+import createJsonDispatchNativeClient from '../json-dispatch-native-client'
+
+describe('react-native: json dispatch native client', () => {
+  const createMockNativeClient = () => ({
+    dispatch: jest.fn(() => 'dispatched'),
+    dispatchJSON: jest.fn(() => 'dispatched json'),
+    leaveBreadcrumb: jest.fn()
+  })
+
+  it('sends payloads as a JSON string', () => {
+    const NativeClient = createMockNativeClient()
+    const client = createJsonDispatchNativeClient(NativeClient)
+    const payload = { errors: [{ errorClass: 'Error', errorMessage: 'oh no', stacktrace: [] }], metadata: { a: { b: 1 } } }
+    expect(client.dispatch(payload)).toBe('dispatched json')
+    expect(NativeClient.dispatchJSON).toHaveBeenCalledWith(JSON.stringify(payload))
+    expect(NativeClient.dispatch).not.toHaveBeenCalled()
+  })
+
+  it('falls back to dispatch() for payloads that cannot be encoded', () => {
+    const NativeClient = createMockNativeClient()
+    const client = createJsonDispatchNativeClient(NativeClient)
+    const payload: any = { metadata: {} }
+    payload.metadata.self = payload
+    expect(client.dispatch(payload)).toBe('dispatched')
+    expect(NativeClient.dispatch).toHaveBeenCalledWith(payload)
+    expect(NativeClient.dispatchJSON).not.toHaveBeenCalled()
+  })
+
+  it('sends batches as a JSON string when the native client supports it', () => {
+    const NativeClient = {
+      ...createMockNativeClient(),
+      leaveBreadcrumbs: jest.fn(),
+      leaveBreadcrumbsJSON: jest.fn(),
+      applyStateChanges: jest.fn()
+    }
+    const client = createJsonDispatchNativeClient(NativeClient)
+    client.leaveBreadcrumbs([{ message: 'a' }])
+    expect(NativeClient.leaveBreadcrumbsJSON).toHaveBeenCalledWith('[{"message":"a"}]')
+    expect(NativeClient.leaveBreadcrumbs).not.toHaveBeenCalled()
+
+    client.applyStateChanges([{ type: 'context', context: 'b' }])
+    expect(NativeClient.applyStateChanges).toHaveBeenCalledWith([{ type: 'context', context: 'b' }])
+  })
+
+  it('passes other calls through', () => {
+    const NativeClient = createMockNativeClient()
+    const client = createJsonDispatchNativeClient(NativeClient)
+    client.leaveBreadcrumb({ message: 'a' })
+    expect(NativeClient.leaveBreadcrumb).toHaveBeenCalledWith({ message: 'a' })
+  })
+
+  it('returns the native client unchanged if it does not support dispatchJSON()', () => {
+    const NativeClient = { dispatch: jest.fn() }
+    expect(createJsonDispatchNativeClient(NativeClient)).toBe(NativeClient)
+  })
+})
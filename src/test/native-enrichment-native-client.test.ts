@@ -0,0 +1,80 @@
+import createNativeEnrichmentNativeClient from '../native-enrichment-native-client'
+
+describe('react-native: native enrichment native client', () => {
+  const createMockNativeClient = () => ({
+    enrichesPayloads: true,
+    dispatch: jest.fn(() => 'dispatched'),
+    getPayloadInfo: jest.fn(),
+    leaveBreadcrumb: jest.fn()
+  })
+
+  it('resolves getPayloadInfo() without calling the native client', async () => {
+    const NativeClient = createMockNativeClient()
+    const client = createNativeEnrichmentNativeClient(NativeClient)
+    client.enrichPayloadsWhen(() => true)
+    await expect(client.getPayloadInfo({ unhandled: true })).resolves.toEqual({
+      app: {},
+      device: {},
+      breadcrumbs: [],
+      threads: []
+    })
+    expect(NativeClient.getPayloadInfo).not.toHaveBeenCalled()
+  })
+
+  it('marks dispatched payloads for the native client to enrich', () => {
+    const NativeClient = createMockNativeClient()
+    const client = createNativeEnrichmentNativeClient(NativeClient)
+    client.enrichPayloadsWhen(() => true)
+    const payload = { errors: [{ errorClass: 'Error', errorMessage: 'oh no', stacktrace: [] }], unhandled: true }
+    expect(client.dispatch(payload)).toBe('dispatched')
+    expect(NativeClient.dispatch).toHaveBeenCalledWith({ ...payload, nativeEnrichment: true })
+    expect(payload).not.toHaveProperty('nativeEnrichment')
+  })
+
+  it('reads the capability from getConstants() when the module has it', () => {
+    const NativeClient = {
+      getConstants: () => ({ enrichesPayloads: true }),
+      dispatch: jest.fn(),
+      getPayloadInfo: jest.fn()
+    }
+    const client = createNativeEnrichmentNativeClient(NativeClient)
+    client.enrichPayloadsWhen(() => true)
+    client.getPayloadInfo({ unhandled: false })
+    expect(NativeClient.getPayloadInfo).not.toHaveBeenCalled()
+  })
+
+  it('calls the native client until enrichment is enabled', () => {
+    const NativeClient = createMockNativeClient()
+    const client = createNativeEnrichmentNativeClient(NativeClient)
+    const payload = { errors: [], unhandled: false }
+    client.getPayloadInfo({ unhandled: false })
+    client.dispatch(payload)
+    expect(NativeClient.getPayloadInfo).toHaveBeenCalledWith({ unhandled: false })
+    expect(NativeClient.dispatch).toHaveBeenCalledWith(payload)
+  })
+
+  it('calls the native client while the condition does not hold', () => {
+    const NativeClient = createMockNativeClient()
+    const client = createNativeEnrichmentNativeClient(NativeClient)
+    let hasCallbacks = true
+    client.enrichPayloadsWhen(() => !hasCallbacks)
+    client.getPayloadInfo({ unhandled: true })
+    expect(NativeClient.getPayloadInfo).toHaveBeenCalledTimes(1)
+
+    hasCallbacks = false
+    client.getPayloadInfo({ unhandled: true })
+    expect(NativeClient.getPayloadInfo).toHaveBeenCalledTimes(1)
+  })
+
+  it('passes other calls through', () => {
+    const NativeClient = createMockNativeClient()
+    const client = createNativeEnrichmentNativeClient(NativeClient)
+    client.leaveBreadcrumb({ message: 'a' })
+    expect(NativeClient.leaveBreadcrumb).toHaveBeenCalledWith({ message: 'a' })
+  })
+
+  it('returns the native client unchanged if it does not enrich payloads', () => {
+    const NativeClient = { dispatch: jest.fn(), getPayloadInfo: jest.fn() }
+    expect(createNativeEnrichmentNativeClient(NativeClient)).toBe(NativeClient)
+  })
+})
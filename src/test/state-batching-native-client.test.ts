@@ -0,0 +1,83 @@
+import createStateBatchingNativeClient from '../state-batching-native-client'
+
+describe('react-native: state batching native client', () => {
+  beforeEach(() => {
+    jest.useFakeTimers()
+  })
+
+  afterEach(() => {
+    jest.useRealTimers()
+  })
+
+  const createMockNativeClient = () => ({
+    applyStateChanges: jest.fn(),
+    updateContext: jest.fn(),
+    updateUser: jest.fn(),
+    updateMetadata: jest.fn(),
+    leaveBreadcrumbs: jest.fn(),
+    dispatch: jest.fn(() => 'dispatched')
+  })
+
+  it('sends queued changes after the flush interval', () => {
+    const NativeClient = createMockNativeClient()
+    const client = createStateBatchingNativeClient(NativeClient, { flushInterval: 50 })
+    client.updateMetadata('app', { a: 1 }, [])
+    client.clearMetadata('device', 'b')
+    expect(NativeClient.applyStateChanges).not.toHaveBeenCalled()
+
+    jest.advanceTimersByTime(50)
+    expect(NativeClient.applyStateChanges).toHaveBeenCalledTimes(1)
+    expect(NativeClient.applyStateChanges).toHaveBeenCalledWith([
+      { type: 'updateMetadata', section: 'app', values: { a: 1 }, removedKeys: [] },
+      { type: 'clearMetadata', section: 'device', key: 'b' }
+    ])
+    expect(NativeClient.updateMetadata).not.toHaveBeenCalled()
+  })
+
+  it('only sends the latest context and user', () => {
+    const NativeClient = createMockNativeClient()
+    const client = createStateBatchingNativeClient(NativeClient)
+    client.updateContext('a')
+    client.updateUser('1', 'a@example.com', 'A')
+    client.updateContext('b')
+    client.updateUser('2', undefined, 'B')
+
+    jest.runAllTimers()
+    expect(NativeClient.applyStateChanges).toHaveBeenCalledWith([
+      { type: 'context', context: 'b' },
+      { type: 'user', id: '2', email: undefined, name: 'B' }
+    ])
+    expect(NativeClient.updateContext).not.toHaveBeenCalled()
+  })
+
+  it('sends a batch as soon as it is full', () => {
+    const NativeClient = createMockNativeClient()
+    const client = createStateBatchingNativeClient(NativeClient, { maxBatchSize: 2 })
+    client.addMetadata('a', { x: 1 })
+    client.addMetadata('b', { x: 1 })
+    client.addMetadata('c', { x: 1 })
+    expect(NativeClient.applyStateChanges).toHaveBeenCalledTimes(1)
+
+    jest.runAllTimers()
+    expect(NativeClient.applyStateChanges).toHaveBeenCalledTimes(2)
+    expect(NativeClient.applyStateChanges).toHaveBeenLastCalledWith([{ type: 'addMetadata', section: 'c', data: { x: 1 } }])
+  })
+
+  it('flushes queued changes before calling any other native method', () => {
+    const NativeClient = createMockNativeClient()
+    const client = createStateBatchingNativeClient(NativeClient)
+    client.updateContext('a')
+    client.leaveBreadcrumbs([{ message: 'b' }])
+    expect(client.dispatch({})).toBe('dispatched')
+    expect(NativeClient.applyStateChanges.mock.invocationCallOrder[0])
+      .toBeLessThan(NativeClient.leaveBreadcrumbs.mock.invocationCallOrder[0])
+
+    jest.runAllTimers()
+    expect(NativeClient.applyStateChanges).toHaveBeenCalledTimes(1)
+  })
+
+  it('returns the native client unchanged if it does not support batches', () => {
+    const NativeClient = { updateContext: jest.fn() }
+    expect(createStateBatchingNativeClient(NativeClient)).toBe(NativeClient)
+  })
+})
@@ -0,0 +1,34 @@
+import createTimingNativeClient from '../timing-native-client'
+
+describe('react-native: timing native client', () => {
+  it('counts calls and the time spent in them', () => {
+    const NativeClient = { leaveBreadcrumb: jest.fn(() => 'left'), updateUser: jest.fn() }
+    const timings: any = {}
+    const client = createTimingNativeClient(NativeClient, timings)
+    expect(client.leaveBreadcrumb({ message: 'a' })).toBe('left')
+    client.leaveBreadcrumb({ message: 'b' })
+    expect(NativeClient.leaveBreadcrumb).toHaveBeenCalledWith({ message: 'b' })
+    expect(timings.leaveBreadcrumb.calls).toBe(2)
+    expect(timings.leaveBreadcrumb.jsMillis).toBeGreaterThanOrEqual(0)
+    expect(timings.updateUser).toBeUndefined()
+  })
+
+  it('counts calls that throw', () => {
+    const NativeClient = { dispatch: jest.fn(() => { throw new Error('oh no') }) }
+    const timings: any = {}
+    const client = createTimingNativeClient(NativeClient, timings)
+    expect(() => client.dispatch({})).toThrow('oh no')
+    expect(timings.dispatch.calls).toBe(1)
+  })
+
+  it('passes other properties through', () => {
+    const NativeClient = { enrichesPayloads: true }
+    const client = createTimingNativeClient(NativeClient, {})
+    expect(client.enrichesPayloads).toBe(true)
+  })
+
+  it('returns the native client unchanged without timings', () => {
+    const NativeClient = { dispatch: jest.fn() }
+    expect(createTimingNativeClient(NativeClient, null)).toBe(NativeClient)
+  })
+})
@@ -0,0 +1,34 @@
+// Benchmarks of the bridge need to know how often each native method is called
+// and how long each call holds up the JS thread, which includes converting its
+// arguments and, for JSI bindings, the native work itself.
+
+const now = typeof global.performance === 'object' && typeof global.performance.now === 'function'
+  ? () => global.performance.now()
+  : () => Date.now()
+
+// Wraps NativeClient so that every method call adds to timings[method], an
+// object with the number of calls and the total milliseconds spent in them.
+module.exports = (NativeClient, timings) => {
+  if (!NativeClient || !timings) return NativeClient
+
+  const wrappers = {}
+  return new Proxy(NativeClient, {
+    get: (target, prop) => {
+      const value = target[prop]
+      if (typeof value !== 'function' || typeof prop !== 'string') return value
+      if (!wrappers[prop]) {
+        wrappers[prop] = (...args) => {
+          const start = now()
+          try {
+            return target[prop](...args)
+          } finally {
+            const timing = timings[prop] || (timings[prop] = { calls: 0, jsMillis: 0 })
+            timing.calls++
+            timing.jsMillis += now() - start
+          }
+        }
+      }
+      return wrappers[prop]
+    }
+  })
+}
@@ -7,7 +7,7 @@ import BugsnagReactNativeStatic, {
 } from '..'
 
 // @ts-ignore
-import { NativeModules } from 'react-native'
+import { InteractionManager, NativeModules } from 'react-native'
 
 const NativeClient = NativeModules.BugsnagReactNative
 
@@ -24,6 +24,9 @@ jest.mock('react-native', () => ({
       dispatch: jest.fn().mockResolvedValue(true)
     }
   },
+  InteractionManager: {
+    runAfterInteractions: jest.fn()
+  },
   Platform: {
     OS: 'android'
   }
@@ -55,6 +58,17 @@ describe('react native notifier', () => {
     expect(Bugsnag.getPlugin('foobar')).toBe(10)
   })
 
+  it('installs breadcrumb collectors once startup interactions have finished', () => {
+    InteractionManager.runAfterInteractions.mockClear()
+    const fetch = window.fetch
+    Bugsnag.start()
+    expect(window.fetch).toBe(fetch)
+
+    expect(InteractionManager.runAfterInteractions).toHaveBeenCalledTimes(1)
+    InteractionManager.runAfterInteractions.mock.calls[0][0]()
+    expect(window.fetch).not.toBe(fetch)
+  })
+
   it('notifies handled errors', (done) => {
     // Explicitly reference the public types to ensure they are exported correctly
     const error: NotifiableError = new Error('123')